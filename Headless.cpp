@@ -0,0 +1,631 @@
+//-------------------------------------------------------------------------------------------------
+// physim-headless
+//
+// Runs projectile scenarios without a window or any SFML graphics, for batch jobs on
+// headless machines. Options come from the command line and/or a config file:
+//
+//     physim-headless throw --speed 11.5 --angle 45 --height 0 --distance 14.32
+//     physim-headless sweep --launches 10000000 --speed 5:20 --angle 0:90 --grid grid.csv
+//     physim-headless sweep --config sweep.cfg --out summary.txt
+//     physim-headless bench
+//     physim-headless replay --in session.rec
+//     physim-headless sweep --launches 1000000 --store sweep.col
+//     physim-headless inspect --in sweep.col --run 42 --trajectory run42.csv
+//     physim-headless sweep --launches 1000000 --trace sweep.json
+//     physim-headless sweep --launches 1000000 --alloc-check
+//
+// A config file holds one "key = value" per line (same keys as the options, '#' starts a
+// comment). Command-line options override the config file.
+//-------------------------------------------------------------------------------------------------
+#include "AllocationTracker.h"
+#include "Benchmarks.h"
+#include "TaskScheduler.h"
+#include "TraceCapture.h"
+#include "src/MotionInDimensions/Ball.h"
+#include "src/MotionInDimensions/LaunchSweep.h"
+#include "src/MotionInDimensions/ProjectileScenario.h"
+#include "src/MotionInDimensions/ProjectileSolver.h"
+#include "src/MotionInDimensions/SessionRecording.h"
+#include "src/MotionInDimensions/TrajectoryStore.h"
+#include "src/MotionInDimensions/TrajectoryWriter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Option Parsing
+//-------------------------------------------------------------------------------------------------
+using OptionMap = std::map<std::string, std::string>;
+
+static const unsigned long long kMaxThreads = 1024;  // --threads
+static const unsigned long long kMaxBins = 4096;     // --speed-bins and --angle-bins
+
+static void printUsage(std::ostream& out) {
+    out << "Usage: physim-headless <throw|sweep|bench|replay|inspect> [options]\n"
+        << "\n"
+        << "Scenario (throw takes single values, sweep takes single values or min:max ranges;\n"
+        << "sweep defaults to speed 5:20, angle 0:90, height 0:" << kMaxLaunchHeight << "):\n"
+        << "  --speed      launch speed in m/s            (default " << kDefaultSpeed << ")\n"
+        << "  --angle      launch angle in degrees, 0 = right, 90 = up (default " << kDefaultAngleDeg << ")\n"
+        << "  --gravity    gravity in m/s^2               (default " << kDefaultGravity << ")\n"
+        << "  --height     launch height above ground, m  (0 .. " << kMaxLaunchHeight << ")\n"
+        << "  --distance   character-to-cart distance, m  (default " << (kCartInitialX - kCharacterInitialX) / kScale << ")\n"
+        << "  --dt         physics step in seconds        (default 1/" << kPhysicsHz << ")\n"
+        << "  --max-steps  steps before a launch times out\n"
+        << "\n"
+        << "Sweep:\n"
+        << "  --launches N           number of Monte Carlo launches\n"
+        << "  --seed N               random seed\n"
+        << "  --threads N            worker threads (0 = all hardware threads, up to " << kMaxThreads << ")\n"
+        << "  --speed-bins N         hit map resolution along speed (1 .. " << kMaxBins << ")\n"
+        << "  --angle-bins N         hit map resolution along angle (1 .. " << kMaxBins << ")\n"
+        << "  --grid FILE            write the hit map as CSV\n"
+        << "  --store FILE           write every launch's trajectory to a columnar store\n"
+        << "  --append-store FILE    add this sweep's launches to an existing store\n"
+        << "\n"
+        << "Replay:\n"
+        << "  --in FILE              session recorded with 'PhySim --record FILE'\n"
+        << "\n"
+        << "Inspect:\n"
+        << "  --in FILE              columnar store written by sweep --store\n"
+        << "  --run N                show one run (and export it with --trajectory)\n"
+        << "\n"
+        << "Trajectory export (throw, replay, inspect):\n"
+        << "  --trajectory FILE      stream every ball state to FILE (.csv = CSV, else binary)\n"
+        << "\n"
+        << "General:\n"
+        << "  --config FILE          read 'key = value' options from FILE\n"
+        << "  --out FILE             write the report to FILE instead of stdout\n"
+        << "  --trace FILE           write a Chrome trace of the run (chrome://tracing, ui.perfetto.dev)\n"
+        << "  --alloc-check          exit with 3 if the simulation loop allocates (throw, sweep;\n"
+        << "                         needs a build with PHYSIM_TRACK_ALLOCATIONS=1)\n";
+}
+
+static std::string trim(const std::string& str) {
+    const char* spaces = " \t\r\n";
+    std::size_t first = str.find_first_not_of(spaces);
+    if (first == std::string::npos) return "";
+    std::size_t last = str.find_last_not_of(spaces);
+    return str.substr(first, last - first + 1);
+}
+
+static bool loadConfigFile(const std::string& path, OptionMap& options) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: Could not open config file '" << path << "'.\n";
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << "Error: " << path << ":" << line_number << ": expected 'key = value'.\n";
+            return false;
+        }
+
+        // Options already given on the command line win
+        std::string key = trim(line.substr(0, equals));
+        if (options.find(key) == options.end()) {
+            options[key] = trim(line.substr(equals + 1));
+        }
+    }
+    return true;
+}
+
+static bool parseFloat(const std::string& str, float& value) {
+    if (str.empty()) return false;
+    char* end = nullptr;
+    value = std::strtof(str.c_str(), &end);
+    return end == str.c_str() + str.size() && std::isfinite(value); // no nan, inf or overflow
+}
+
+static bool parseRange(const std::string& str, SweepRange& range) {
+    std::size_t colon = str.find(':');
+    if (colon == std::string::npos) {
+        float value;
+        if (!parseFloat(str, value)) return false;
+        range = { value, value };
+        return true;
+    }
+    return parseFloat(str.substr(0, colon), range.min) && parseFloat(str.substr(colon + 1), range.max)
+        && range.min <= range.max;
+}
+
+// Parsers for a value / range that must lie in [min_value, max_value]
+static auto floatIn(float min_value, float max_value) {
+    return [min_value, max_value](const std::string& str, float& value) {
+        return parseFloat(str, value) && value >= min_value && value <= max_value;
+    };
+}
+
+static auto rangeIn(float min_value, float max_value) {
+    return [min_value, max_value](const std::string& str, SweepRange& range) {
+        return parseRange(str, range) && range.min >= min_value && range.max <= max_value;
+    };
+}
+
+static bool parseCount(const std::string& str, unsigned long long& value) {
+    // strtoull would take "-1" as a huge count
+    if (str.empty() || !std::isdigit(static_cast<unsigned char>(str[0]))) return false;
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoull(str.c_str(), &end, 10);
+    return end == str.c_str() + str.size() && errno != ERANGE;
+}
+
+// A parser for counts in [min_value, max_value], for options stored in narrower types
+static auto countIn(unsigned long long min_value, unsigned long long max_value) {
+    return [min_value, max_value](const std::string& str, unsigned long long& value) {
+        return parseCount(str, value) && value >= min_value && value <= max_value;
+    };
+}
+
+// Reads option "key" with "parse" if it is present. Returns false on a malformed value.
+template <typename T, typename Parser>
+static bool readOption(const OptionMap& options, const char* key, T& value, Parser parse) {
+    auto it = options.find(key);
+    if (it == options.end()) return true;
+    if (!parse(it->second, value)) {
+        std::cerr << "Error: Invalid value '" << it->second << "' for --" << key << ".\n";
+        return false;
+    }
+    return true;
+}
+
+// The throw command's scenario: every parameter is a single value
+static bool readLaunch(const OptionMap& options, ProjectileLaunch& launch, float& dt, int& max_steps) {
+    launch = { kDefaultSpeed, kDefaultAngleDeg, kDefaultGravity, 0.f, (kCartInitialX - kCharacterInitialX) / kScale };
+    dt = kPhysicsDt;
+    unsigned long long steps = 100000;
+
+    bool ok = readOption(options, "speed", launch.speed_m_s, parseFloat)
+        && readOption(options, "angle", launch.angle_deg, parseFloat)
+        && readOption(options, "gravity", launch.gravity, parseFloat)
+        && readOption(options, "height", launch.launch_height_m, floatIn(0.f, kMaxLaunchHeight))
+        && readOption(options, "distance", launch.cart_distance_m, parseFloat)
+        && readOption(options, "dt", dt, parseFloat)
+        && readOption(options, "max-steps", steps, countIn(1, INT_MAX));
+    max_steps = static_cast<int>(steps);
+    return ok;
+}
+
+static bool readSweepConfig(const OptionMap& options, LaunchSweepConfig& config, unsigned long long& threads) {
+    unsigned long long launches = config.launches;
+    unsigned long long seed = config.seed;
+    unsigned long long max_steps = static_cast<unsigned long long>(config.max_steps);
+    unsigned long long speed_bins = static_cast<unsigned long long>(config.speed_bins);
+    unsigned long long angle_bins = static_cast<unsigned long long>(config.angle_bins);
+    threads = 0;
+
+    bool ok = readOption(options, "speed", config.speed_m_s, parseRange)
+        && readOption(options, "angle", config.angle_deg, parseRange)
+        && readOption(options, "gravity", config.gravity, parseRange)
+        && readOption(options, "height", config.launch_height_m, rangeIn(0.f, kMaxLaunchHeight))
+        && readOption(options, "distance", config.cart_distance_m, parseRange)
+        && readOption(options, "dt", config.dt, parseFloat)
+        && readOption(options, "launches", launches, countIn(0, SIZE_MAX))
+        && readOption(options, "seed", seed, parseCount)
+        && readOption(options, "max-steps", max_steps, countIn(1, INT_MAX))
+        && readOption(options, "speed-bins", speed_bins, countIn(1, kMaxBins))
+        && readOption(options, "angle-bins", angle_bins, countIn(1, kMaxBins))
+        && readOption(options, "threads", threads, countIn(0, kMaxThreads));
+
+    config.launches = static_cast<std::size_t>(launches);
+    config.seed = seed;
+    config.max_steps = static_cast<int>(max_steps);
+    config.speed_bins = static_cast<int>(speed_bins);
+    config.angle_bins = static_cast<int>(angle_bins);
+    return ok;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Trajectory Export
+//-------------------------------------------------------------------------------------------------
+
+// Starts the writer if --trajectory was given. Returns false if the file can't be written.
+static bool openTrajectory(const OptionMap& options, TrajectoryWriter& writer) {
+    auto path = options.find("trajectory");
+    if (path == options.end()) return true;
+
+    if (!writer.open(path->second, getTrajectoryFormatForPath(path->second))) {
+        std::cerr << "Error: Could not write '" << path->second << "'.\n";
+        return false;
+    }
+    return true;
+}
+
+// Finishes writing and reports what made it to disk (nothing if --trajectory wasn't given).
+// Returns false on a write error.
+static bool closeTrajectory(TrajectoryWriter& writer, std::ostream& out) {
+    if (!writer.isOpen()) return true;
+    writer.close();
+
+    out << "Trajectory: " << writer.getSamplesWritten() << " samples written ("
+        << writer.getBytesWritten() << " bytes), " << writer.getSamplesDropped() << " dropped\n";
+    if (writer.hasWriteError()) {
+        std::cerr << "Error: Writing the trajectory failed.\n";
+        return false;
+    }
+    if (writer.getSamplesDropped() > 0) {
+        std::cerr << "Error: The trajectory is incomplete (" << writer.getSamplesDropped() << " samples dropped).\n";
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Commands
+//-------------------------------------------------------------------------------------------------
+static const char* exitEdgeName(ExitEdge edge) {
+    switch (edge) {
+    case ExitEdge::Left:   return "left";
+    case ExitEdge::Right:  return "right";
+    case ExitEdge::Top:    return "top";
+    case ExitEdge::Bottom: return "bottom";
+    default:               return "none";
+    }
+}
+
+// --alloc-check: once set up, the simulation loops must not touch the heap
+static bool checkAllocations(const OptionMap& options, const char* loop, std::uint64_t allocations, std::ostream& out) {
+    if (options.count("alloc-check") == 0) return true;
+    out << "Allocations in " << loop << ": " << allocations << "\n";
+    if (allocations > 0) {
+        std::cerr << "Error: The " << loop << " made " << allocations << " heap allocations.\n";
+        return false;
+    }
+    return true;
+}
+
+static int runThrow(const OptionMap& options, std::ostream& out) {
+    ProjectileLaunch launch;
+    float dt;
+    int max_steps;
+    if (!readLaunch(options, launch, dt, max_steps)) return 2;
+
+    TrajectoryWriter trajectory;
+    if (!openTrajectory(options, trajectory)) return 2;
+
+    // Stepped exactly like the simulation window does it (swept checks, rewound to the hit).
+    // The exported path comes from the same steps as the outcome.
+    ProjectileSetup setup = makeProjectileSetup(launch.launch_height_m, launch.cart_distance_m);
+    Ball ball(setup.start_x_m, setup.start_y_m, launch.speed_m_s, launch.angle_deg, launch.gravity);
+    const bool exporting = trajectory.isOpen();
+    if (exporting) trajectory.pushWait(0, 0.f, ball.getState());
+
+    int steps = 0;
+    BallStepResult result = BallStepResult::Flying;
+    const std::uint64_t allocations_before = getThreadAllocations().count;
+    while (steps < max_steps && result == BallStepResult::Flying) {
+        result = ball.advance(dt, setup.basket_x_m, setup.basket_y_m, kBasketRadius, setup.max_x_m, setup.max_y_m);
+        ++steps;
+        if (exporting) trajectory.pushWait(0, steps * dt, ball.getState());
+    }
+    const std::uint64_t allocations = getThreadAllocations().count - allocations_before;
+    LaunchOutcome outcome = result == BallStepResult::Scored ? LaunchOutcome::Scored
+        : result == BallStepResult::OutOfBounds ? LaunchOutcome::OutOfBounds : LaunchOutcome::TimedOut;
+
+    // Closed form of the same throw (start state as in the Ball constructor)
+    float angle_rad = launch.angle_deg * 3.14159f / 180.f;
+    ProjectileOutcome predicted = solveProjectile(setup.start_x_m, setup.start_y_m,
+        launch.speed_m_s * std::cos(angle_rad), -launch.speed_m_s * std::sin(angle_rad), launch.gravity,
+        setup.basket_x_m, setup.basket_y_m, kBasketRadius, setup.max_x_m, setup.max_y_m, dt);
+
+    out << std::fixed << std::setprecision(4);
+    out << "Throw: speed " << launch.speed_m_s << " m/s, angle " << launch.angle_deg << " deg, gravity "
+        << launch.gravity << " m/s^2, height " << launch.launch_height_m << " m, distance "
+        << launch.cart_distance_m << " m\n";
+    out << "Simulated:  " << (outcome == LaunchOutcome::Scored ? "Goal!" : outcome == LaunchOutcome::OutOfBounds ? "No Goal!" : "Timed out")
+        << " after " << steps << " steps (" << steps * dt << " s)\n";
+    out << "Predicted:  " << (predicted.scored ? "Goal!" : "No Goal!")
+        << " closest " << predicted.min_distance_m << " m at " << predicted.closest_time_s << " s, apex "
+        << predicted.apex_rise_m << " m above launch at " << predicted.apex_time_s << " s, exits "
+        << exitEdgeName(predicted.exit_edge) << " at " << predicted.exit_time_s << " s\n";
+
+    if (!closeTrajectory(trajectory, out)) return 2;
+    if (!checkAllocations(options, "physics loop", allocations, out)) return 3;
+
+    return outcome == LaunchOutcome::Scored ? 0 : 1;
+}
+
+static int runSweep(const OptionMap& options, std::ostream& out) {
+    LaunchSweepConfig config;
+    unsigned long long threads;
+    if (!readSweepConfig(options, config, threads)) return 2;
+
+    TaskScheduler scheduler(static_cast<unsigned int>(threads));
+    LaunchSweepResult result = runLaunchSweep(config, scheduler);
+    writeSweepSummary(result, config, out);
+    if (!checkAllocations(options, "sweep loop", result.allocations, out)) return 3;
+
+    auto grid = options.find("grid");
+    if (grid != options.end()) {
+        std::ofstream grid_file(grid->second);
+        if (!grid_file) {
+            std::cerr << "Error: Could not write '" << grid->second << "'.\n";
+            return 2;
+        }
+        writeSweepGridCsv(result, config, grid_file);
+    }
+
+    // Full trajectories go to the columnar store
+    auto store_path = options.find("store");
+    auto append_path = options.find("append-store");
+    if (store_path != options.end() || append_path != options.end()) {
+        TrajectoryStoreWriter store;
+        std::string error;
+        bool opened = store_path != options.end()
+            ? store.create(store_path->second, config.dt, error)
+            : store.openForAppend(append_path->second, error);
+        if (!opened) {
+            std::cerr << "Error: " << error << ".\n";
+            return 2;
+        }
+
+        bool ok = writeSweepStore(config, scheduler, store);
+        std::uint64_t runs = store.getRunCount();
+        std::uint64_t samples = store.getSampleCount();
+        if (!store.close() || !ok) {
+            std::cerr << "Error: Writing the trajectory store failed.\n";
+            return 2;
+        }
+        out << "Store: " << runs << " runs, " << samples << " samples\n";
+    }
+    return 0;
+}
+
+static int runBench(std::ostream& out) {
+    benchmarkIntegrationKernels(out);
+    out << "\n";
+    benchmarkBroadphaseScaling(out);
+    out << "\n";
+    benchmarkThreadScaling(out);
+    return 0;
+}
+
+static int runReplay(const OptionMap& options, std::ostream& out) {
+    auto in_path = options.find("in");
+    if (in_path == options.end()) {
+        std::cerr << "Error: replay needs --in FILE.\n";
+        return 2;
+    }
+
+    RecordedSession session;
+    std::string error;
+    if (!loadSession(in_path->second, session, error)) {
+        std::cerr << "Error: " << error << ".\n";
+        return 2;
+    }
+
+    ReplayReport report = replaySession(session);
+    writeReplayReport(report, out);
+
+    TrajectoryWriter trajectory;
+    if (!openTrajectory(options, trajectory)) return 2;
+    if (trajectory.isOpen()) {
+        for (std::size_t t = 0; t < session.throws.size(); ++t) {
+            const std::vector<BallState>& steps = session.throws[t].steps;
+            for (std::size_t i = 0; i < steps.size(); ++i) {
+                trajectory.pushWait(static_cast<std::uint32_t>(t), (i + 1) * session.physics_dt, steps[i]);
+            }
+        }
+    }
+    if (!closeTrajectory(trajectory, out)) return 2;
+
+    return report.mismatched_throws == 0 ? 0 : 1;
+}
+
+static const char* launchOutcomeName(LaunchOutcome outcome) {
+    switch (outcome) {
+    case LaunchOutcome::Scored:      return "Goal!";
+    case LaunchOutcome::OutOfBounds: return "No Goal!";
+    default:                         return "Timed out";
+    }
+}
+
+static int runInspect(const OptionMap& options, std::ostream& out) {
+    auto in_path = options.find("in");
+    if (in_path == options.end()) {
+        std::cerr << "Error: inspect needs --in FILE.\n";
+        return 2;
+    }
+
+    TrajectoryStoreReader store;
+    std::string error;
+    if (!store.open(in_path->second, error)) {
+        std::cerr << "Error: " << error << ".\n";
+        return 2;
+    }
+
+    // Outcome totals straight from the mapped outcome column
+    const std::uint32_t* outcomes = static_cast<const std::uint32_t*>(store.getColumn(StoreColumn::RunOutcome));
+    std::uint64_t totals[3] = { 0, 0, 0 };
+    for (std::uint64_t r = 0; r < store.getRunCount(); ++r) {
+        if (outcomes[r] < 3) ++totals[outcomes[r]];
+    }
+
+    out << std::fixed << std::setprecision(6);
+    out << "Store: " << store.getRunCount() << " runs, " << store.getSampleCount() << " samples, dt = "
+        << store.getPhysicsDt() << " s\n";
+    out << "  hits " << totals[static_cast<int>(LaunchOutcome::Scored)]
+        << ", out of bounds " << totals[static_cast<int>(LaunchOutcome::OutOfBounds)]
+        << ", timed out " << totals[static_cast<int>(LaunchOutcome::TimedOut)] << "\n";
+
+    unsigned long long index = 0;
+    if (options.find("run") == options.end()) return 0;
+    if (!readOption(options, "run", index, parseCount)) return 2;
+    if (index >= store.getRunCount()) {
+        std::cerr << "Error: Run " << index << " is out of range.\n";
+        return 2;
+    }
+
+    StoredRun run = store.getRun(static_cast<std::size_t>(index));
+    out << std::setprecision(4);
+    out << "Run " << index << ": speed " << run.launch.speed_m_s << " m/s, angle " << run.launch.angle_deg
+        << " deg, gravity " << run.launch.gravity << " m/s^2, height " << run.launch.launch_height_m
+        << " m, distance " << run.launch.cart_distance_m << " m\n";
+    out << "  " << launchOutcomeName(run.outcome) << " after " << run.sample_count << " samples\n";
+
+    TrajectoryWriter trajectory;
+    if (!openTrajectory(options, trajectory)) return 2;
+    if (trajectory.isOpen()) {
+        for (std::size_t i = 0; i < run.sample_count; ++i) {
+            trajectory.pushWait(TrajectorySample{ static_cast<std::uint32_t>(index), run.t_s[i],
+                run.x_m[i], run.y_m[i], run.vx_m_s[i], run.vy_m_s[i] });
+        }
+    }
+    if (!closeTrajectory(trajectory, out)) return 2;
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry Point
+//-------------------------------------------------------------------------------------------------
+
+// Rejects options the command doesn't read (from the command line or the config file), so
+// a typo like --sped fails instead of silently running with the default
+static bool checkOptionKeys(const std::string& command, const OptionMap& options) {
+    static const std::vector<std::string> kGeneralKeys = { "config", "out", "trace", "alloc-check" };
+    static const std::map<std::string, std::vector<std::string>> kCommandKeys = {
+        { "throw", { "speed", "angle", "gravity", "height", "distance", "dt", "max-steps", "trajectory" } },
+        { "sweep", { "speed", "angle", "gravity", "height", "distance", "dt", "max-steps", "launches", "seed",
+            "threads", "speed-bins", "angle-bins", "grid", "store", "append-store" } },
+        { "bench", {} },
+        { "replay", { "in", "trajectory" } },
+        { "inspect", { "in", "run", "trajectory" } }
+    };
+
+    auto command_keys = kCommandKeys.find(command);
+    if (command_keys == kCommandKeys.end()) return true; // runCommand reports the command
+
+    for (const auto& option : options) {
+        const std::string& key = option.first;
+        if (std::find(kGeneralKeys.begin(), kGeneralKeys.end(), key) == kGeneralKeys.end()
+            && std::find(command_keys->second.begin(), command_keys->second.end(), key) == command_keys->second.end()) {
+            std::cerr << "Error: Unknown option --" << key << " for " << command << ".\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+static int runCommand(const std::string& command, const OptionMap& options, std::ostream& out) {
+    TraceZone zone("Command");
+    if (command == "throw") return runThrow(options, out);
+    if (command == "sweep") return runSweep(options, out);
+    if (command == "bench") return runBench(out);
+    if (command == "replay") return runReplay(options, out);
+    if (command == "inspect") return runInspect(options, out);
+
+    std::cerr << "Error: Unknown command '" << command << "'.\n";
+    printUsage(std::cerr);
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h") {
+        printUsage(argc < 2 ? std::cerr : std::cout);
+        return argc < 2 ? 2 : 0;
+    }
+
+    const std::string command = argv[1];
+
+    // "--key value" or "--key=value", except for the flags, which take no value
+    OptionMap options;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            std::cerr << "Error: Unexpected argument '" << arg << "'.\n";
+            return 2;
+        }
+        arg.erase(0, 2);
+
+        if (arg == "alloc-check") {
+            options[arg] = "1";
+            continue;
+        }
+
+        std::size_t equals = arg.find('=');
+        if (equals != std::string::npos) {
+            options[arg.substr(0, equals)] = arg.substr(equals + 1);
+        }
+        else if (i + 1 < argc) {
+            options[arg] = argv[++i];
+        }
+        else {
+            std::cerr << "Error: Missing value for --" << arg << ".\n";
+            return 2;
+        }
+    }
+
+    auto config = options.find("config");
+    if (config != options.end() && !loadConfigFile(config->second, options)) {
+        return 2;
+    }
+    if (!checkOptionKeys(command, options)) {
+        printUsage(std::cerr);
+        return 2;
+    }
+
+    // Report goes to stdout unless --out is given
+    std::ofstream out_file;
+    auto out_path = options.find("out");
+    if (out_path != options.end()) {
+        out_file.open(out_path->second);
+        if (!out_file) {
+            std::cerr << "Error: Could not write '" << out_path->second << "'.\n";
+            return 2;
+        }
+    }
+    std::ostream& out = out_file.is_open() ? static_cast<std::ostream&>(out_file) : std::cout;
+
+    if (options.count("alloc-check") != 0) {
+        if (!kAllocationTrackingEnabled) {
+            std::cerr << "Error: --alloc-check needs a build with PHYSIM_TRACK_ALLOCATIONS=1.\n";
+            return 2;
+        }
+        if (command != "throw" && command != "sweep") {
+            std::cerr << "Error: --alloc-check works with throw and sweep.\n";
+            return 2;
+        }
+    }
+
+    auto trace_path = options.find("trace");
+    if (trace_path != options.end()) {
+        std::string error;
+        if (!startTraceCapture(trace_path->second, error)) {
+            std::cerr << "Error: " << error << "\n";
+            return 2;
+        }
+        setTraceThreadName("Main");
+    }
+
+    int result = runCommand(command, options, out);
+
+    if (trace_path != options.end()) {
+        std::uint64_t dropped = stopTraceCapture();
+        if (dropped > 0) {
+            std::cerr << "Warning: " << dropped << " trace events were dropped (buffers full).\n";
+        }
+    }
+    return result;
+}
@@ -1,118 +1,123 @@
 #include "Main.h"
+#include "AllocationTracker.h"
+#include "ResourceCache.h"
+#include "SimulationRegistry.h"
+#include "TextureAtlas.h"
+#include "TraceCapture.h"
 #include "../src/MotionInDimensions/ProjectileMotion.h"
+#include "../src/MotionInDimensions/ProjectileScenario.h"
+#include "../src/MotionInDimensions/SessionRecording.h"
+#include "../src/MotionInDimensions/StoredRunScene.h"
 #include <SFML/Graphics.hpp>
-#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
 #include <string>
 #include <iostream>
 
-int main() {
+// Steady frames a scene draws before --alloc-check starts counting its allocations
+static const int kAllocCheckWarmupFrames = 30;
+
+int main(int argc, char* argv[]) {
+    // "--record <file>" records the projectile session for replay with physim-headless,
+    // "--trace <file>" writes a Chrome trace of every profiler zone (see TraceCapture.h),
+    // "--alloc-check" reports every steady frame that allocates and then exits with 3,
+    // "--view-store <file> [--run <n>]" opens a trajectory store written by
+    // "physim-headless sweep --store" and plays its runs (see StoredRunScene.h)
+    SessionRecorder recorder;
+    bool tracing = false;
+    std::string view_store;
+    std::size_t view_run = 0;
+    bool alloc_check = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--alloc-check") {
+            if (!kAllocationTrackingEnabled) {
+                std::cerr << "Error: --alloc-check needs a build with PHYSIM_TRACK_ALLOCATIONS=1.\n";
+                return -1;
+            }
+            alloc_check = true;
+        }
+    }
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--record") {
+            if (!recorder.open(argv[i + 1], kPhysicsDt)) {
+                std::cerr << "Error: Could not write '" << argv[i + 1] << "'.\n";
+                return -1;
+            }
+        }
+        else if (std::string(argv[i]) == "--trace") {
+            std::string error;
+            if (!startTraceCapture(argv[i + 1], error)) {
+                std::cerr << "Error: " << error << "\n";
+                return -1;
+            }
+            setTraceThreadName("Main");
+            tracing = true;
+        }
+        else if (std::string(argv[i]) == "--view-store") {
+            view_store = argv[i + 1];
+        }
+        else if (std::string(argv[i]) == "--run") {
+            char* end = nullptr;
+            view_run = static_cast<std::size_t>(std::strtoull(argv[i + 1], &end, 10));
+            if (*argv[i + 1] == '\0' || *end != '\0') {
+                std::cerr << "Error: Invalid run '" << argv[i + 1] << "'.\n";
+                return -1;
+            }
+        }
+    }
+
     sf::RenderWindow window(sf::VideoMode(1920, 1080), "Physics Simulations Dashboard", sf::Style::Close);
     window.setFramerateLimit(60);
 
-    sf::Font font;
-    if (!font.loadFromFile("retrogaming.ttf")) {
+    // Shared with the simulations, which get the already loaded font from the cache
+    std::string load_error;
+    ResourceCache<sf::Font>::Handle font_handle = ResourceCache<sf::Font>::getDefault().load("retrogaming.ttf", load_error);
+    if (!font_handle) {
+        std::cerr << "Error: " << load_error << "\n";
         return -1;
     }
+    const sf::Font& font = *font_handle;
 
-    // Colors
-    sf::Color bgColor = sf::Color::Black;
-    sf::Color textColor = sf::Color::White;
-    sf::Color highlightColor = sf::Color::Green;
+    std::uint32_t alloc_failures = 0;
 
-    // Menus
-    std::vector<std::string> mainMenuItems = { "Simulate", "Quit" };
-    std::vector<std::string> simTopicsMenuItems = { "Motion in One and Two Dimensions" };
-    std::vector<std::string> motionOneDimSubMenuItems = {
-        "Projectile Motion"
-    };
-
-    AppState currentState = AppState::MainMenu;
-    std::vector<std::string>* currentMenuItems = &mainMenuItems;
-    std::vector<sf::Text> currentTextObjects = createMenuTextObj(*currentMenuItems, font, textColor);
-    sf::RectangleShape currentMenuBox = positionMenuAndCreateBox(currentTextObjects, window, highlightColor);
-
-    int selectedItem = 0;
-    currentTextObjects[selectedItem].setFillColor(highlightColor);
-
-    auto updateMenu = [&](std::vector<std::string>& items) {
-        currentTextObjects = createMenuTextObj(items, font, textColor);
-        currentMenuBox = positionMenuAndCreateBox(currentTextObjects, window, highlightColor);
-        selectedItem = 0;
-        currentTextObjects[selectedItem].setFillColor(highlightColor);
-        };
-
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
-            }
-
-            if (event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::Up) {
-                    currentTextObjects[selectedItem].setFillColor(textColor);
-                    selectedItem = (selectedItem - 1 + (int)currentMenuItems->size()) % (int)currentMenuItems->size();
-                    currentTextObjects[selectedItem].setFillColor(highlightColor);
-                }
-                else if (event.key.code == sf::Keyboard::Down) {
-                    currentTextObjects[selectedItem].setFillColor(textColor);
-                    selectedItem = (selectedItem + 1) % (int)currentMenuItems->size();
-                    currentTextObjects[selectedItem].setFillColor(highlightColor);
-                }
-                else if (event.key.code == sf::Keyboard::Enter) {
-                    std::string chosen = (*currentMenuItems)[selectedItem];
-
-                    if (currentState == AppState::MainMenu) {
-                        if (chosen == "Simulate") {
-                            currentState = AppState::SimTopicsMenu;
-                            currentMenuItems = &simTopicsMenuItems;
-                            updateMenu(*currentMenuItems);
-                        }
-                        else if (chosen == "Quit") {
-                            window.close();
-                        }
-                    }
-                    else if (currentState == AppState::SimTopicsMenu) {
-                        if (chosen == "Motion in One and Two Dimensions") {
-                            currentState = AppState::MotionOneDimSubMenu;
-                            currentMenuItems = &motionOneDimSubMenuItems;
-                            updateMenu(*currentMenuItems);
-                        }
-                    }
-                    else if (currentState == AppState::MotionOneDimSubMenu) {
-                        if (chosen == "Projectile Motion") {
-                            // Run the projectile motion simulation:
-                            // Close the current menu window and then run simulation in a separate window.
-                            window.close();
-                            runProjectileMotionSimulation();
-                        }
-                    }
-                }
-                else if (event.key.code == sf::Keyboard::Escape) {
-                    if (currentState == AppState::MotionOneDimSubMenu) {
-                        currentState = AppState::SimTopicsMenu;
-                        currentMenuItems = &simTopicsMenuItems;
-                        updateMenu(*currentMenuItems);
-                    }
-                    else if (currentState == AppState::SimTopicsMenu) {
-                        currentState = AppState::MainMenu;
-                        currentMenuItems = &mainMenuItems;
-                        updateMenu(*currentMenuItems);
-                    }
-                    else if (currentState == AppState::MainMenu) {
-                        window.close();
-                    }
-                }
+    // The menu is the bottom scene; simulations are pushed on top of it. The registry
+    // goes first when the block ends, so a running prefetch finishes while the window
+    // still exists.
+    {
+        SceneStack stack(window, font);
+        SimulationRegistry registry;
+        registerProjectileMotion(registry);
+        if (alloc_check) {
+            stack.enableAllocationCheck(kAllocCheckWarmupFrames);
+        }
+        stack.push(std::make_unique<MenuScene>(stack, font, registry, recorder.isOpen() ? &recorder : nullptr));
+        if (!view_store.empty()) {
+            // The viewer opens on top of the menu; Escape goes back to it
+            auto viewer = std::make_unique<StoredRunScene>(stack, view_store, view_run);
+            if (!viewer->load(load_error)) {
+                std::cerr << "Error: " << load_error << "\n";
+                return -1;
             }
+            stack.push(std::move(viewer));
         }
+        stack.run();
+        alloc_failures = stack.getAllocationFailures();
+    }
 
-        window.clear(bgColor);
-        window.draw(currentMenuBox);
-        for (auto& t : currentTextObjects) {
-            window.draw(t);
-        }
-        window.display();
+    if (tracing) {
+        stopTraceCapture();
     }
 
+    // Free the cached fonts and textures while SFML's OpenGL context still exists,
+    // rather than in the caches' static destructors
+    font_handle.reset();
+    ResourceCache<sf::Font>::getDefault().evictUnused();
+    ResourceCache<TextureAtlas>::getDefault().evictUnused();
+
+    if (alloc_failures > 0) {
+        std::cerr << "Allocation check failed: " << alloc_failures << " steady frames allocated.\n";
+        return 3;
+    }
     return 0;
 }
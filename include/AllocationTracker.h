@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// Allocation tracking replaces the global operator new/delete with versions that count
+// every heap allocation (and its size) per thread. Like profiling it is compiled in for
+// debug builds; release builds keep the standard operators unless the project defines
+// PHYSIM_TRACK_ALLOCATIONS=1.
+#ifndef PHYSIM_TRACK_ALLOCATIONS
+#ifdef NDEBUG
+#define PHYSIM_TRACK_ALLOCATIONS 0
+#else
+#define PHYSIM_TRACK_ALLOCATIONS 1
+#endif
+#endif
+
+constexpr bool kAllocationTrackingEnabled = PHYSIM_TRACK_ALLOCATIONS != 0;
+
+struct AllocationCounts {
+	std::uint64_t count = 0;
+	std::uint64_t bytes = 0;
+};
+
+// Allocations the calling thread made since it started (always 0 when tracking is
+// compiled out). Take two readings and subtract to count a stretch of code:
+//
+//     AllocationCounts before = getThreadAllocations();
+//     ...
+//     std::uint64_t allocations = getThreadAllocations().count - before.count;
+AllocationCounts getThreadAllocations();
+
+// Allocations every thread made since the program started
+AllocationCounts getTotalAllocations();
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ostream>
+
+// Micro-benchmarks for the physics core. Each one prints a small table to "out".
+
+// Particles/sec of every integration kernel this CPU supports, and whether it
+// matches the scalar reference bit for bit
+void benchmarkIntegrationKernels(std::ostream& out);
+
+// Spatial hash rebuild + neighbour-pair query time from 10k to 1M particles
+// at constant density (time per particle should stay roughly flat)
+void benchmarkBroadphaseScaling(std::ostream& out);
+
+// Speedup of a 1M-particle step (integration + broadphase pair query) on the
+// work-stealing scheduler with 1, 2, 4, ... threads up to the hardware count
+void benchmarkThreadScaling(std::ostream& out);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef>
+
+// An sf::Text for values that are redrawn every frame (distances, timings, ...). Numbers
+// are formatted with std::to_chars into a fixed buffer, and the text is only given a new
+// string when the characters differ from what it already shows, so an unchanged value
+// costs no glyph layout and no heap allocation:
+//
+//     HudText distance;
+//     distance.getText().setFont(font);
+//     distance.setNumber("Distance: ", dist_m, 2, " m"); // "Distance: 12.35 m"
+//
+// Style the text through getText(), but set its string only through HudText.
+class HudText {
+	public:
+		static constexpr std::size_t kMaxLength = 95; // longer strings are cut off
+
+		HudText();
+
+		void setString(const char* chars);
+		void setString(const char* chars, std::size_t length);
+
+		// prefix + value with "precision" decimals + suffix
+		void setNumber(const char* prefix, float value, int precision, const char* suffix = "");
+
+		sf::Text& getText() { return text; }
+		const sf::Text& getText() const { return text; }
+
+	private:
+		char shown[kMaxLength + 1] = {};
+		std::size_t shown_length = 0;
+
+		// Converting a char string to an sf::String allocates every time, so new strings are
+		// written into "glyphs" (always kMaxLength long) and copied into "visible", whose
+		// storage is reused once it has held the longest string
+		sf::String glyphs;
+		sf::String visible;
+		sf::Text text;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+// Instruction sets the integration kernels can be built for, from slowest to fastest
+enum class SimdLevel {
+	Scalar,
+	SSE2,
+	AVX2,
+	AVX512
+};
+
+// Pointers to the SoA arrays a kernel works on (all arrays hold "count" floats)
+struct IntegrationBuffers {
+	float* x;
+	float* y;
+	float* vx;
+	float* vy;
+	float* ax;
+	float* ay;
+	std::size_t count;
+};
+
+// A kernel performs one semi-implicit Euler step over every entry:
+//     v += a * dt,  p += v * dt,  a = 0
+// Every kernel uses separate multiplies and adds (never fused), so the SIMD paths
+// give bit-identical results to the scalar reference.
+using IntegrationKernel = void (*)(const IntegrationBuffers& buffers, float dt);
+
+// Scalar reference implementation
+void integrateScalar(const IntegrationBuffers& buffers, float dt);
+
+// Highest instruction set supported by this CPU (and enabled by the OS), checked with cpuid
+SimdLevel detectSimdLevel();
+
+bool isSimdLevelSupported(SimdLevel level);
+const char* getSimdLevelName(SimdLevel level);
+
+// Kernel for a specific level, or nullptr if this build/CPU cannot run it
+IntegrationKernel getIntegrationKernel(SimdLevel level);
+
+// Best kernel for this CPU (detected once, then cached)
+IntegrationKernel getBestIntegrationKernel();
+
+// Runs the "level" kernel and the scalar reference on the same random data and
+// compares the results bit for bit
+bool matchesScalarReference(SimdLevel level, std::size_t count = 4099, int steps = 16);
+
+// Integrates "count" particles for "steps" steps and returns the throughput in particles/sec
+double measureIntegrationThroughput(SimdLevel level, std::size_t count, int steps);
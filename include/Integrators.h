@@ -0,0 +1,108 @@
+#pragma once
+
+// Compile-time integrator policies.
+//
+// Each policy is a struct with a static "step" function template, so a simulation
+// picks its integrator as a template argument and the inner loop is fully inlined
+// (no virtual calls). All policies work on any "State" with two members:
+//
+//     state.position, state.velocity   (same vector type "Vec")
+//
+// where Vec supports "Vec + Vec" and "Vec * float" (Vec2f does).
+// The acceleration is supplied as a callable:
+//
+//     Vec accel(const Vec& position, const Vec& velocity)
+//
+// Velocity Verlet and Yoshida are symplectic (energy stays bounded over long runs)
+// when the acceleration only depends on position.
+
+template <typename Vec>
+struct KinematicState {
+	Vec position;
+	Vec velocity;
+};
+
+// Semi-implicit (symplectic) Euler - what Particle::update and Ball::update have always done.
+// 1st order, 1 acceleration evaluation per step.
+struct SemiImplicitEuler {
+	static constexpr int kOrder = 1;
+
+	template <typename State, typename Accel>
+	static void step(State& s, float dt, Accel&& accel) {
+		// velocity = velocity + acceleration * dt
+		s.velocity = s.velocity + accel(s.position, s.velocity) * dt;
+
+		// position = position + velocity * dt
+		s.position = s.position + s.velocity * dt;
+	}
+};
+
+// Velocity Verlet (kick-drift-kick). 2nd order, symplectic, 2 evaluations per step.
+struct VelocityVerlet {
+	static constexpr int kOrder = 2;
+
+	template <typename State, typename Accel>
+	static void step(State& s, float dt, Accel&& accel) {
+		const float half_dt = 0.5f * dt;
+		auto v_half = s.velocity + accel(s.position, s.velocity) * half_dt;
+		s.position = s.position + v_half * dt;
+		s.velocity = v_half + accel(s.position, v_half) * half_dt;
+	}
+};
+
+// Classic 4th order Runge-Kutta. Not symplectic, but very accurate for short runs
+// and velocity-dependent forces (like drag). 4 evaluations per step.
+struct RK4 {
+	static constexpr int kOrder = 4;
+
+	template <typename State, typename Accel>
+	static void step(State& s, float dt, Accel&& accel) {
+		const float half_dt = 0.5f * dt;
+		const auto p0 = s.position;
+		const auto v0 = s.velocity;
+
+		// k = (dp/dt, dv/dt) evaluated at four points inside the step
+		const auto k1_p = v0;
+		const auto k1_v = accel(p0, v0);
+
+		const auto k2_p = v0 + k1_v * half_dt;
+		const auto k2_v = accel(p0 + k1_p * half_dt, k2_p);
+
+		const auto k3_p = v0 + k2_v * half_dt;
+		const auto k3_v = accel(p0 + k2_p * half_dt, k3_p);
+
+		const auto k4_p = v0 + k3_v * dt;
+		const auto k4_v = accel(p0 + k3_p * dt, k4_p);
+
+		const float sixth_dt = dt / 6.f;
+		s.position = p0 + (k1_p + k2_p * 2.f + k3_p * 2.f + k4_p) * sixth_dt;
+		s.velocity = v0 + (k1_v + k2_v * 2.f + k3_v * 2.f + k4_v) * sixth_dt;
+	}
+};
+
+// 4th order Yoshida (three Verlet-style sub-steps with tuned weights).
+// Symplectic like Verlet, but 4th order accurate. 3 evaluations per step.
+struct Yoshida4 {
+	static constexpr int kOrder = 4;
+
+	// w1 = 1 / (2 - 2^(1/3)),  w0 = -2^(1/3) / (2 - 2^(1/3))
+	static constexpr float kW1 = 1.3512071919596578f;
+	static constexpr float kW0 = -1.7024143839193153f;
+
+	// Drift (position) and kick (velocity) weights
+	static constexpr float kC1 = 0.5f * kW1;
+	static constexpr float kC2 = 0.5f * (kW0 + kW1);
+	static constexpr float kD1 = kW1;
+	static constexpr float kD2 = kW0;
+
+	template <typename State, typename Accel>
+	static void step(State& s, float dt, Accel&& accel) {
+		s.position = s.position + s.velocity * (kC1 * dt);
+		s.velocity = s.velocity + accel(s.position, s.velocity) * (kD1 * dt);
+		s.position = s.position + s.velocity * (kC2 * dt);
+		s.velocity = s.velocity + accel(s.position, s.velocity) * (kD2 * dt);
+		s.position = s.position + s.velocity * (kC2 * dt);
+		s.velocity = s.velocity + accel(s.position, s.velocity) * (kD1 * dt);
+		s.position = s.position + s.velocity * (kC1 * dt);
+	}
+};
@@ -1,15 +1,59 @@
 #pragma once
+#include "Scene.h"
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <string>
 
+class SessionRecorder;
+class SimulationRegistry;
+struct SimulationInfo;
+
 enum class AppState {
     MainMenu,
     SimTopicsMenu,
-    MotionOneDimSubMenu,
-    ProjectileSimulation
+    SimulationsMenu
 };
 
 std::vector<sf::Text> createMenuTextObj(const std::vector<std::string>& menuItems, const sf::Font& font, sf::Color textColor);
 
 sf::RectangleShape positionMenuAndCreateBox(std::vector<sf::Text>& textObjects, sf::RenderWindow& window, sf::Color highlightColor);
+
+// The dashboard menus: main menu, the topics, then the simulations of one topic, all
+// built from the registry. Highlighting a simulation prefetches its assets, choosing
+// it pushes its scene; Escape goes back a menu level.
+class MenuScene : public Scene {
+    public:
+        // If "recorder" is given, the simulations record their sessions into it
+        MenuScene(SceneStack& stack, const sf::Font& font, SimulationRegistry& registry, SessionRecorder* recorder = nullptr);
+
+        const char* getTitle() const override { return "Physics Simulations Dashboard"; }
+        void handleEvent(const sf::Event& event) override;
+        void update(float frameTime) override;
+        void draw(sf::RenderWindow& window, SpriteBatch& batch) override;
+
+    private:
+        void showMenu(AppState state, std::vector<std::string>& items);
+        void select(int item);
+        void showSimulations(const std::string& topic);
+
+        SceneStack& stack;
+        const sf::Font& font;
+        SimulationRegistry& registry;
+        SessionRecorder* recorder;
+
+        // Colors
+        sf::Color textColor = sf::Color::White;
+        sf::Color highlightColor = sf::Color::Green;
+
+        // Menus
+        std::vector<std::string> mainMenuItems = { "Simulate", "Quit" };
+        std::vector<std::string> simTopicsMenuItems;
+        std::vector<std::string> simulationsMenuItems;
+        std::vector<const SimulationInfo*> simulations; // the entries of simulationsMenuItems
+
+        AppState currentState = AppState::MainMenu;
+        std::vector<std::string>* currentMenuItems = nullptr;
+        std::vector<sf::Text> currentTextObjects;
+        sf::RectangleShape currentMenuBox;
+        int selectedItem = 0;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A file mapped into memory (mmap on POSIX, a file mapping on Windows).
+// The bytes can be read and, for writable files, written in place through data();
+// the operating system pages them in and out, so files far larger than RAM work.
+class MappedFile {
+	public:
+		enum class Mode {
+			ReadOnly,  // open an existing file
+			ReadWrite, // open an existing file for in-place changes
+			Create     // create (or truncate) a file for writing
+		};
+
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Create needs a non-zero size; the other modes map the whole existing file
+		bool open(const std::string& path, Mode mode, std::size_t size = 0);
+		void close();
+
+		// Grows or shrinks a writable file (remaps it, so old data() pointers become invalid)
+		bool resize(std::size_t size);
+
+		// Writes dirty pages back to the file
+		bool flush();
+
+		bool isOpen() const { return mapping != nullptr; }
+		bool isWritable() const { return writable; }
+		std::uint8_t* data() { return mapping; }
+		const std::uint8_t* data() const { return mapping; }
+		std::size_t size() const { return mapped_size; }
+
+	private:
+		bool map(std::size_t size);
+		void unmap();
+
+		std::uint8_t* mapping = nullptr;
+		std::size_t mapped_size = 0;
+		bool writable = false;
+
+#if defined(_WIN32)
+		void* file_handle = nullptr;
+		void* mapping_handle = nullptr;
+#else
+		int file_descriptor = -1;
+#endif
+};
@@ -1,38 +1,72 @@
 #pragma once
 
-#include <SFML/System.hpp> // for sf::Vector2f (2d vector)
+#include "Integrators.h"
+#include "Vec2.h"
 
 class Particle {
 	public:
 		// Particle constructor (runs when a particle is created)
 		Particle(
-			const sf::Vector2f& pos = sf::Vector2f(0.f, 0.f),
-			const sf::Vector2f& vel = sf::Vector2f(0.f, 0.f),
+			const Vec2f& pos = Vec2f(0.f, 0.f),
+			const Vec2f& vel = Vec2f(0.f, 0.f),
 			float mass = 1.f
 		);
 
 		// "update" will move the particle based on its velocity and acceleration
 		void update(float dt);
 
+		// "integrate" moves the particle like "update", but with any integrator policy
+		// from Integrators.h, e.g. particle.integrate<VelocityVerlet>(dt)
+		template <typename Integrator>
+		void integrate(float dt);
+
+		// Same, with an extra acceleration field (like a spring) that depends on where
+		// the particle is: accel(position, velocity) is called inside the step
+		template <typename Integrator, typename Accel>
+		void integrate(float dt, Accel&& accel);
+
 		// "applyForce" applies force to the particle (like gravity, etc)
-		void applyForce(const sf::Vector2f &force);
+		void applyForce(const Vec2f &force);
 
 		// Set the particle's position, velocity, acceleration, and mass
-		void setPosition(const sf::Vector2f &pos);
-		void setVelocity(const sf::Vector2f &vel);
-		void setAcceleration(const sf::Vector2f &acc);
+		void setPosition(const Vec2f &pos);
+		void setVelocity(const Vec2f &vel);
+		void setAcceleration(const Vec2f &acc);
 		void setMass(float m);
 
-		const sf::Vector2f& getPosition() const;
-		const sf::Vector2f& getVelocity() const;
-		const sf::Vector2f& getAcceleration() const;
+		const Vec2f& getPosition() const;
+		const Vec2f& getVelocity() const;
+		const Vec2f& getAcceleration() const;
 		float getMass() const;
 
 	private:
 		// These are the "parts" of a Particle:
-		sf::Vector2f position;
-		sf::Vector2f velocity;
-		sf::Vector2f acceleration;
+		Vec2f position;
+		Vec2f velocity;
+		Vec2f acceleration;
 		float mass;
 };
 
+template <typename Integrator>
+void Particle::integrate(float dt) {
+	integrate<Integrator>(dt, [](const Vec2f&, const Vec2f&) {
+		return Vec2f(0.f, 0.f);
+	});
+}
+
+template <typename Integrator, typename Accel>
+void Particle::integrate(float dt, Accel&& accel) {
+	// The forces applied this frame give a constant acceleration over the step
+	const Vec2f applied = acceleration;
+
+	KinematicState<Vec2f> state = { position, velocity };
+	Integrator::step(state, dt, [&](const Vec2f& pos, const Vec2f& vel) {
+		return applied + accel(pos, vel);
+	});
+	position = state.position;
+	velocity = state.velocity;
+
+	// Reset acceleration so each frame we can apply new forces
+	acceleration = Vec2f(0.f, 0.f);
+}
+
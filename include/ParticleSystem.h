@@ -0,0 +1,110 @@
+#pragma once
+
+#include "AlignedAllocator.h"
+#include "Integrators.h"
+#include "Particle.h"
+#include "TaskScheduler.h"
+#include "Vec2.h"
+
+#include <cstddef>
+#include <vector>
+
+// One aligned, contiguous float array (64-byte aligned so SIMD loads never split a cache line)
+using FloatArray = std::vector<float, AlignedAllocator<float, 64>>;
+
+// ParticleSystem stores many particles as a "structure of arrays" (SoA):
+// instead of one Particle object per body, every attribute lives in its own
+// array, so stepping the whole system is one tight loop over contiguous memory.
+//
+// The integration is the same semi-implicit Euler used by Particle::update:
+//     velocity += acceleration * dt
+//     position += velocity * dt
+//     acceleration = 0
+class ParticleSystem {
+	public:
+		ParticleSystem() = default;
+
+		// Reserve room for "count" particles so adding them does not reallocate
+		void reserve(std::size_t count);
+
+		// Remove every particle
+		void clear();
+
+		// Add a particle and return its index in the system
+		std::size_t addParticle(const Particle& particle);
+		std::size_t addParticle(
+			const Vec2f& pos,
+			const Vec2f& vel = Vec2f(0.f, 0.f),
+			float mass = 1.f
+		);
+
+		// Advance every particle by one step of time (dt)
+		void step(float dt);
+
+		// Same, split into chunks that run on the scheduler's threads
+		void step(float dt, TaskScheduler& scheduler);
+
+		// Advance every particle with any integrator policy from Integrators.h.
+		// step(dt) is the vectorized semi-implicit Euler fast path; this version runs
+		// one particle at a time but lets higher-order methods take larger steps.
+		template <typename Integrator>
+		void stepWith(float dt);
+
+		// "applyForce" applies force to a single particle (a = F/m)
+		void applyForce(std::size_t index, const Vec2f& force);
+
+		// Adds the same acceleration (like gravity) to every particle, independent of mass
+		void applyAcceleration(const Vec2f& acc);
+
+		// Copy a particle back out as a regular Particle object
+		Particle getParticle(std::size_t index) const;
+
+		Vec2f getPosition(std::size_t index) const;
+		Vec2f getVelocity(std::size_t index) const;
+		Vec2f getAcceleration(std::size_t index) const;
+		float getMass(std::size_t index) const;
+
+		std::size_t size() const { return x.size(); }
+		bool empty() const { return x.empty(); }
+
+		// Raw array access for batch kernels
+		float* positionsX() { return x.data(); }
+		float* positionsY() { return y.data(); }
+		float* velocitiesX() { return vx.data(); }
+		float* velocitiesY() { return vy.data(); }
+		float* accelerationsX() { return ax.data(); }
+		float* accelerationsY() { return ay.data(); }
+		float* inverseMasses() { return invMass.data(); }
+
+		const float* positionsX() const { return x.data(); }
+		const float* positionsY() const { return y.data(); }
+		const float* velocitiesX() const { return vx.data(); }
+		const float* velocitiesY() const { return vy.data(); }
+		const float* accelerationsX() const { return ax.data(); }
+		const float* accelerationsY() const { return ay.data(); }
+		const float* inverseMasses() const { return invMass.data(); }
+
+	private:
+		// Every array has one entry per particle
+		FloatArray x, y;       // position
+		FloatArray vx, vy;     // velocity
+		FloatArray ax, ay;     // acceleration (cleared after every step)
+		FloatArray invMass;    // 1 / mass, so forces are applied with a multiply
+};
+
+template <typename Integrator>
+void ParticleSystem::stepWith(float dt) {
+	const std::size_t count = size();
+	for (std::size_t i = 0; i < count; ++i) {
+		const Vec2f acc(ax[i], ay[i]);
+		KinematicState<Vec2f> state = { Vec2f(x[i], y[i]), Vec2f(vx[i], vy[i]) };
+		Integrator::step(state, dt, [&acc](const Vec2f&, const Vec2f&) { return acc; });
+
+		x[i] = state.position.x;
+		y[i] = state.position.y;
+		vx[i] = state.velocity.x;
+		vy[i] = state.velocity.y;
+		ax[i] = 0.f;
+		ay[i] = 0.f;
+	}
+}
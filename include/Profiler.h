@@ -0,0 +1,161 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "AllocationTracker.h"
+#include "TraceCapture.h"
+
+// Profiling is compiled in for debug builds. Release builds compile every timer down to
+// nothing unless the project defines PHYSIM_PROFILING=1.
+#ifndef PHYSIM_PROFILING
+#ifdef NDEBUG
+#define PHYSIM_PROFILING 0
+#else
+#define PHYSIM_PROFILING 1
+#endif
+#endif
+
+constexpr bool kProfilingEnabled = PHYSIM_PROFILING != 0;
+
+// Collects how long each named zone of a frame took (and, with allocation tracking, how
+// many heap allocations it made), for the last kHistoryFrames frames.
+// While a trace capture is running (TraceCapture.h) every frame and zone is also
+// recorded as a trace event:
+//
+//     FrameProfiler profiler;
+//     const int zone_physics = profiler.addZone("Physics");
+//     while (running) {
+//         profiler.beginFrame();
+//         {
+//             ScopedTimer timer(profiler, zone_physics);
+//             ...
+//         }
+//         profiler.endFrame();
+//     }
+class FrameProfiler {
+	public:
+		static constexpr int kMaxZones = 8;
+		static constexpr int kHistoryFrames = 240;
+
+		using Clock = std::chrono::steady_clock;
+
+		// Returns the zone's id (or -1 once kMaxZones zones exist). Adding a name that
+		// already exists returns the existing zone, so scenes can add their zones each time
+		// they're created.
+		int addZone(const char* name);
+
+		void beginFrame() {
+			if constexpr (kProfilingEnabled) {
+				frame_start = Clock::now();
+				for (int z = 0; z < kMaxZones; ++z) current[z] = 0;
+				if constexpr (kAllocationTrackingEnabled) {
+					frame_allocations_start = getThreadAllocations();
+					for (int z = 0; z < kMaxZones; ++z) current_allocations[z] = AllocationCounts();
+				}
+			}
+		}
+
+		// Stores this frame's zone totals (and its whole duration) in the history
+		void endFrame();
+
+		void addTime(int zone, std::int64_t nanoseconds) {
+			if constexpr (kProfilingEnabled) {
+				if (zone >= 0 && zone < kMaxZones) current[zone] += nanoseconds;
+			}
+		}
+
+		void addAllocations(int zone, std::uint64_t count, std::uint64_t bytes) {
+			if constexpr (kProfilingEnabled && kAllocationTrackingEnabled) {
+				if (zone >= 0 && zone < kMaxZones) {
+					current_allocations[zone].count += count;
+					current_allocations[zone].bytes += bytes;
+				}
+			}
+		}
+
+		int getZoneCount() const { return zone_count; }
+		const char* getZoneName(int zone) const { return zone_names[zone]; }
+
+		// Frames in the history (up to kHistoryFrames)
+		int getFrameCount() const { return frame_count; }
+
+		// Milliseconds spent in "zone" (kWholeFrame = the whole frame) "framesAgo" frames
+		// back (0 = the last finished frame)
+		static constexpr int kWholeFrame = kMaxZones;
+		float getMs(int zone, int framesAgo) const {
+			int index = (next_frame - 1 - framesAgo + kHistoryFrames) % kHistoryFrames;
+			return history[index][zone];
+		}
+
+		// Percentile (0..1, e.g. 0.5 or 0.99) of "zone" over the history, in milliseconds
+		float getPercentileMs(int zone, float percentile) const;
+
+		// Heap allocations made on the profiling thread in "zone" (kWholeFrame = anywhere in
+		// the frame) "framesAgo" frames back. Always 0 without allocation tracking.
+		const AllocationCounts& getAllocations(int zone, int framesAgo) const {
+			int index = (next_frame - 1 - framesAgo + kHistoryFrames) % kHistoryFrames;
+			return allocation_history[index][zone];
+		}
+
+	private:
+		const char* zone_names[kMaxZones] = {};
+		int zone_count = 0;
+
+		Clock::time_point frame_start;
+		std::int64_t current[kMaxZones] = {};
+
+		float history[kHistoryFrames][kMaxZones + 1] = {};
+		AllocationCounts frame_allocations_start;
+		AllocationCounts current_allocations[kMaxZones];
+		AllocationCounts allocation_history[kHistoryFrames][kMaxZones + 1];
+		int next_frame = 0;
+		int frame_count = 0;
+};
+
+// Adds the time (and the allocations) from construction to stop() (or the end of the
+// scope) to a zone, and records it in the running trace capture. Compiles to nothing
+// when profiling is off.
+class ScopedTimer {
+	public:
+		ScopedTimer(FrameProfiler& profiler, int zone) : profiler(profiler), zone(zone) {
+			if constexpr (kProfilingEnabled) {
+				if constexpr (kAllocationTrackingEnabled) {
+					start_allocations = getThreadAllocations();
+				}
+				start = FrameProfiler::Clock::now();
+			}
+		}
+
+		~ScopedTimer() {
+			stop();
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		// Ends the measurement early (later calls do nothing)
+		void stop() {
+			if constexpr (kProfilingEnabled) {
+				if (zone < 0) return;
+				auto end = FrameProfiler::Clock::now();
+				profiler.addTime(zone, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+				if constexpr (kAllocationTrackingEnabled) {
+					AllocationCounts now = getThreadAllocations();
+					profiler.addAllocations(zone, now.count - start_allocations.count, now.bytes - start_allocations.bytes);
+				}
+				if (isTraceCapturing()) {
+					recordTraceEvent(profiler.getZoneName(zone),
+						std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count(),
+						std::chrono::duration_cast<std::chrono::nanoseconds>(end.time_since_epoch()).count());
+				}
+				zone = -1;
+			}
+		}
+
+	private:
+		FrameProfiler& profiler;
+		int zone;
+		FrameProfiler::Clock::time_point start;
+		AllocationCounts start_allocations;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "HudText.h"
+#include "Profiler.h"
+#include "SpriteBatch.h"
+
+#include <SFML/Graphics.hpp>
+
+// On-screen view of a FrameProfiler: the last FrameProfiler::kHistoryFrames frames as a
+// stacked bar graph (one color per zone, newest frame on the right) and the p50/p99
+// time of every zone (with allocation tracking, also its allocations in the last frame),
+// plus the last frame's draw calls when given a SpriteBatch's counters. Hidden until toggled (F3 in the simulation windows).
+class ProfilerOverlay {
+	public:
+		explicit ProfilerOverlay(const sf::Font& font);
+
+		void toggle() { visible = !visible; }
+		bool isVisible() const { return visible; }
+
+		// Draws in the target's default view, so it stays in the corner whatever the camera does
+		void draw(sf::RenderTarget& target, const FrameProfiler& profiler, const SpriteBatchStats* batchStats = nullptr);
+
+	private:
+		bool visible = false;
+
+		sf::RectangleShape panel;
+		sf::VertexArray bars;
+		sf::VertexArray budget_line;
+		HudText lines[FrameProfiler::kMaxZones + 2]; // zones, whole frame, draw calls
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Loads each resource (font, texture, atlas, ...) once and shares it between everyone
+// who asks for the same path:
+//
+//     auto font = ResourceCache<sf::Font>::getDefault().load("retrogaming.ttf", error);
+//     if (!font) { ... error ... }
+//     sf::Text text("Hello", *font, 30);
+//
+// Handles are reference counted. The cache keeps its own reference, so a resource stays
+// loaded after its last user lets go (re-opening a simulation doesn't touch the disk)
+// until evictUnused() drops everything only the cache still holds.
+// Safe to use from several threads; two threads loading the same path at once may both
+// read the file, but they end up sharing one copy.
+template <typename T>
+class ResourceCache {
+	public:
+		using Handle = std::shared_ptr<const T>;
+
+		// One cache per resource type for the whole program
+		static ResourceCache& getDefault() {
+			static ResourceCache cache;
+			return cache;
+		}
+
+		// Loads with T::loadFromFile(path). Returns nullptr (and sets "error") if that fails.
+		Handle load(const std::string& path, std::string& error) {
+			return load(path, [&](T& resource, std::string& load_error) {
+				if (!resource.loadFromFile(path)) {
+					load_error = "Could not load '" + path + "'.";
+					return false;
+				}
+				return true;
+			}, error);
+		}
+
+		// Loads with loader(T&, std::string& error) -> bool, for resources that aren't a
+		// single file (like a TextureAtlas); "key" names the result in the cache
+		template <typename Loader>
+		Handle load(const std::string& key, Loader loader, std::string& error) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				auto it = resources.find(key);
+				if (it != resources.end()) {
+					return it->second;
+				}
+			}
+
+			// Load without holding the lock, so other resources can load at the same time
+			auto resource = std::make_shared<T>();
+			if (!loader(*resource, error)) {
+				return nullptr;
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			auto inserted = resources.emplace(key, resource);
+			return inserted.first->second; // someone else's copy if they finished first
+		}
+
+		bool contains(const std::string& key) const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return resources.count(key) != 0;
+		}
+
+		// Drops every resource nobody but the cache is using, returns how many
+		std::size_t evictUnused() {
+			std::lock_guard<std::mutex> lock(mutex);
+			std::size_t evicted = 0;
+			for (auto it = resources.begin(); it != resources.end();) {
+				if (it->second.use_count() == 1) {
+					it = resources.erase(it);
+					++evicted;
+				}
+				else {
+					++it;
+				}
+			}
+			return evicted;
+		}
+
+		std::size_t size() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return resources.size();
+		}
+
+	private:
+		mutable std::mutex mutex;
+		std::map<std::string, std::shared_ptr<const T>> resources;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Profiler.h"
+#include "ProfilerOverlay.h"
+#include "SpriteBatch.h"
+
+#include <SFML/Graphics.hpp>
+
+#include <memory>
+#include <vector>
+
+class SceneStack;
+
+// One screen of the app: a menu, a simulation, ... Every scene shares the one window
+// (and its OpenGL context), and only the scene on top of the stack runs.
+class Scene {
+	public:
+		virtual ~Scene() = default;
+
+		// Shown in the window's title bar while the scene is on top
+		virtual const char* getTitle() const = 0;
+
+		// Every window event, including Closed (the stack closes the window itself). Call
+		// SceneStack::invalidate() when the event changes what's on screen.
+		virtual void handleEvent(const sf::Event& event) = 0;
+
+		// While true the stack redraws every frame (e.g. a ball is flying). Otherwise it only
+		// redraws after invalidate() and sleeps until the next event in between.
+		virtual bool isAnimating() const { return false; }
+
+		// Once per redrawn frame with the real time since the last frame, in seconds
+		// (0 for the first frame after the stack slept)
+		virtual void update(float frameTime) = 0;
+
+		// The window is already cleared; anything queued in "batch" is drawn after this
+		virtual void draw(sf::RenderWindow& window, SpriteBatch& batch) = 0;
+
+		// Called when the scene is on top again after the scene above it was popped
+		virtual void onResume() {}
+};
+
+// Runs the scenes in one window:
+//
+//     SceneStack stack(window, font);
+//     stack.push(std::make_unique<MenuScene>(stack, font));
+//     stack.run(); // until the window closes or the last scene is popped
+//
+// push/pop/replace take effect at the end of the current frame, so a scene can pop
+// itself from inside its own handleEvent or update.
+// Nothing is redrawn while the top scene is idle: the stack waits for the next event
+// and only draws a frame once something was invalidated.
+// The stack owns the frame profiler (F3 shows it) and the sprite batch.
+class SceneStack {
+	public:
+		SceneStack(sf::RenderWindow& window, const sf::Font& overlayFont);
+
+		void push(std::unique_ptr<Scene> scene);
+		void pop();
+		void replace(std::unique_ptr<Scene> scene);
+
+		void run();
+
+		// Redraw at the end of this frame's events (no need while the scene is animating)
+		void invalidate() { redraw = true; }
+
+		sf::RenderWindow& getWindow() { return window; }
+		FrameProfiler& getProfiler() { return profiler; }
+
+		// Frames since run() started (keeps counting across scenes)
+		std::uint32_t getFrameIndex() const { return frame_index; }
+
+		// Allocation check (needs allocation tracking, see AllocationTracker.h): once a scene
+		// has drawn "warmupFrames" steady frames (frames drawn only because it's animating or
+		// the overlay is open, not because something was invalidated), every further steady
+		// frame that allocates is reported on std::cerr. The frame's total comes from the
+		// allocation tracker; the per-zone breakdown only shows with profiling compiled in.
+		void enableAllocationCheck(int warmupFrames) { allocation_check_warmup = warmupFrames; }
+		std::uint32_t getAllocationFailures() const { return allocation_failures; }
+
+	private:
+		enum class ChangeType { Push, Pop, Replace };
+		struct Change {
+			ChangeType type;
+			std::unique_ptr<Scene> scene;
+		};
+
+		void applyChanges();
+		void dispatchEvent(Scene& scene, const sf::Event& event);
+		bool needsRedraw(const Scene& scene) const;
+		void checkAllocations(const AllocationCounts& frame);
+
+		sf::RenderWindow& window;
+		std::vector<std::unique_ptr<Scene>> scenes;
+		std::vector<Change> changes;
+
+		FrameProfiler profiler;
+		int zone_events;
+		int zone_draw;
+		int zone_display;
+		ProfilerOverlay profiler_overlay;
+		SpriteBatch sprite_batch;
+
+		std::uint32_t frame_index = 0;
+		bool redraw = true;
+
+		int allocation_check_warmup = -1; // -1 = off
+		int steady_frames = 0;            // since the last scene change
+		std::uint32_t allocation_failures = 0;
+};
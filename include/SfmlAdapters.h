@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Vec2.h"
+
+#include <SFML/System/Vector2.hpp> // for sf::Vector2f (2d vector)
+
+// Conversions between the physics core's Vec2f and SFML's sf::Vector2f.
+// Only the SFML front end includes this; the core never sees SFML.
+inline sf::Vector2f toSfml(const Vec2f& v) {
+	return sf::Vector2f(v.x, v.y);
+}
+
+inline Vec2f fromSfml(const sf::Vector2f& v) {
+	return Vec2f(v.x, v.y);
+}
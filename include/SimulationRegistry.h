@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ResourceCache.h"
+#include "Scene.h"
+#include "TextureAtlas.h"
+
+#include <SFML/Graphics.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class SessionRecorder;
+
+// The images packed into one TextureAtlas; "cache_path" is both the atlas' key in
+// ResourceCache<TextureAtlas> and where the packed texture is cached on disk
+struct AtlasManifest {
+	std::string cache_path;
+	std::vector<std::pair<std::string, std::string>> images; // name, file
+};
+
+// Everything a simulation loads before its first frame
+struct AssetManifest {
+	std::vector<std::string> fonts;
+	std::vector<AtlasManifest> atlases;
+};
+
+// Gets the atlas from ResourceCache<TextureAtlas>, packing it (or reading the disk cache) if
+// it isn't loaded yet
+ResourceCache<TextureAtlas>::Handle loadAtlas(const AtlasManifest& manifest, std::string& error);
+
+// Loads every font and atlas of "manifest" into the resource caches
+bool loadAssets(const AssetManifest& manifest, std::string& error);
+
+struct SimulationInfo {
+	std::string topic;      // menu listing the simulation, e.g. "Motion in One and Two Dimensions"
+	std::string name;       // its entry in that menu
+	AssetManifest assets;
+
+	// Makes the scene (its assets are already in the caches when prefetched). Returns
+	// nullptr and sets "error" if the scene can't start.
+	std::function<std::unique_ptr<Scene>(SceneStack& stack, SessionRecorder* recorder, std::string& error)> create;
+};
+
+// Every simulation the dashboard offers. The menus are built from it, and a simulation's
+// assets are prefetched on a background thread while its menu entry is highlighted:
+//
+//     SimulationRegistry registry;
+//     registerProjectileMotion(registry);
+//     ...
+//     registry.prefetch(*info);                                  // entry highlighted
+//     auto scene = registry.createScene(*info, stack, recorder, error); // Enter
+//
+// Prefetched resources stay in the ResourceCaches, so only the first visit reads the disk.
+// Destroy the registry before the window: it waits for a running prefetch to finish.
+class SimulationRegistry {
+	public:
+		SimulationRegistry() = default;
+		~SimulationRegistry();
+
+		SimulationRegistry(const SimulationRegistry&) = delete;
+		SimulationRegistry& operator=(const SimulationRegistry&) = delete;
+
+		void add(SimulationInfo info);
+
+		// Topics in the order their first simulation was added
+		std::vector<std::string> getTopics() const;
+		std::vector<const SimulationInfo*> getSimulations(const std::string& topic) const;
+		const SimulationInfo* find(const std::string& name) const;
+
+		// Queues the simulation's assets for the loader thread; does nothing if they're
+		// already loaded or queued. Never blocks.
+		void prefetch(const SimulationInfo& info);
+
+		// Waits for the simulation's prefetch (if one is queued or running), then calls its factory
+		std::unique_ptr<Scene> createScene(const SimulationInfo& info, SceneStack& stack, SessionRecorder* recorder, std::string& error);
+
+	private:
+		enum class AssetState { NotLoaded, Queued, Loading, Loaded };
+
+		struct Entry {
+			SimulationInfo info;
+			AssetState state = AssetState::NotLoaded;
+		};
+
+		Entry* findEntry(const SimulationInfo& info);
+		void loaderLoop();
+
+		// Entries are never removed, so the SimulationInfo pointers handed out stay valid
+		std::deque<Entry> entries;
+
+		std::thread loader;
+		std::mutex mutex;              // guards the states, "queue" and "stopping"
+		std::condition_variable changed;
+		std::deque<Entry*> queue;
+		bool stopping = false;
+};
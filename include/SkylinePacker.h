@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+// Packs rectangles into a fixed-size area with the skyline bottom-left method:
+// it keeps the "skyline" (the top edge of everything placed so far) as a list of
+// horizontal segments, and puts each new rectangle where its top ends up lowest.
+// Packing the tallest rectangles first gives the tightest result.
+class SkylinePacker {
+	public:
+		SkylinePacker(int width, int height);
+
+		// Finds a place for a width x height rectangle and reserves it.
+		// Returns false (and changes nothing) if it doesn't fit anywhere.
+		bool insert(int width, int height, int& x, int& y);
+
+		// Lowest height that holds everything placed so far
+		int getUsedHeight() const { return used_height; }
+
+	private:
+		struct Segment {
+			int x;
+			int y;
+			int width;
+		};
+
+		// Top of a rectangle of "width" placed at the start of segment "index" (-1 if it doesn't fit)
+		int fitAt(std::size_t index, int width, int height) const;
+
+		std::vector<Segment> skyline;
+		int width;
+		int height;
+		int used_height = 0;
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "ParticleSystem.h"
+#include "TaskScheduler.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Uniform-grid spatial hash used as a broadphase: it finds which particles are
+// close to each other without testing every pair (O(N) instead of O(N^2)).
+//
+// The plane is cut into square cells of "cellSize". Every cell is hashed into a
+// table, and the particles are counting-sorted by their bucket, so each bucket's
+// particles sit next to each other in memory. Rebuilding is linear in the number
+// of particles, so the hash is simply rebuilt every step.
+//
+// When the particles' bounding box has few enough cells, every cell gets its own
+// bucket (a plain uniform grid); otherwise cells wrap around the table and the
+// distance check filters out the extra particles that share a bucket.
+class SpatialHash {
+	public:
+		explicit SpatialHash(float cellSize = 1.f);
+
+		// A cell size close to the query radius is usually fastest. Radii up to twice
+		// the cell size look at no more than 5x5 cells; larger radii still find every
+		// neighbour, but scan all particles for each query.
+		void setCellSize(float size);
+		float getCellSize() const { return cellSize; }
+
+		// Rebuild from the current particle positions
+		void build(const ParticleSystem& system);
+		void build(const float* x, const float* y, std::size_t count);
+
+		// Calls callback(i, j) once for every pair of particles closer than "radius"
+		// (i and j are particle indices, i != j, each pair reported once)
+		template <typename Callback>
+		void forEachNeighbourPair(float radius, Callback&& callback) const;
+
+		// Parallel version: the callback is called from several threads at once
+		template <typename Callback>
+		void forEachNeighbourPair(TaskScheduler& scheduler, float radius, Callback&& callback) const;
+
+		// Only the pairs whose first particle is in sorted slots [slotBegin, slotEnd).
+		// Splitting [0, size()) into ranges gives every pair exactly once.
+		template <typename Callback>
+		void forEachNeighbourPairInSlots(std::size_t slotBegin, std::size_t slotEnd, float radius, Callback&& callback) const;
+
+		// Calls callback(i) for every particle closer than "radius" to (px, py)
+		template <typename Callback>
+		void forEachNeighbour(float px, float py, float radius, Callback&& callback) const;
+
+		// Collects every close pair into "pairs" (cleared first)
+		void findNeighbourPairs(float radius, std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs) const;
+
+		std::size_t size() const { return sortedIndices.size(); }
+		std::size_t getBucketCount() const { return cellStart.empty() ? 0 : cellStart.size() - 1; }
+
+	private:
+		std::uint32_t bucketOf(std::int32_t cx, std::int32_t cy) const {
+			// Row-major cell number relative to the bounds seen at build time, wrapped
+			// into the table. Neighbouring cells in a row land in neighbouring buckets,
+			// so the sorted particles stay in spatial order (good cache locality).
+			std::uint32_t row = static_cast<std::uint32_t>(cy - originY);
+			std::uint32_t col = static_cast<std::uint32_t>(cx - originX);
+			return (row * gridWidth + col) & bucketMask;
+		}
+
+		std::int32_t cellCoord(float v) const {
+			return static_cast<std::int32_t>(std::floor(v * invCellSize));
+		}
+
+		// Sorted slots [begin, end) of one bucket
+		struct SlotRange {
+			std::uint32_t begin;
+			std::uint32_t end;
+		};
+		static constexpr int kMaxQueryRanges = 32;
+
+		// Slot ranges of the distinct buckets of the cells overlapping the square around
+		// (px, py). When that's more than kMaxQueryRanges cells, it's one range with every slot.
+		int gatherSlotRanges(float px, float py, float radius, SlotRange* ranges) const;
+
+		float cellSize;
+		float invCellSize;
+		std::uint32_t bucketMask = 0;
+		std::int32_t originX = 0, originY = 0; // cell of the bounding box's min corner
+		std::uint32_t gridWidth = 1;           // cells per row of the bounding box
+
+		std::vector<std::uint32_t> cellStart;     // bucket b holds sorted slots [cellStart[b], cellStart[b + 1])
+		std::vector<std::uint32_t> cellCursor;    // scratch for the counting sort
+		std::vector<std::uint32_t> particleBucket; // bucket of every particle (by particle index)
+		std::vector<std::uint32_t> sortedIndices; // particle index stored in each sorted slot
+		FloatArray sortedX, sortedY;              // positions in sorted order (cache-friendly queries)
+};
+
+template <typename Callback>
+void SpatialHash::forEachNeighbourPair(float radius, Callback&& callback) const {
+	forEachNeighbourPairInSlots(0, sortedIndices.size(), radius, callback);
+}
+
+template <typename Callback>
+void SpatialHash::forEachNeighbourPair(TaskScheduler& scheduler, float radius, Callback&& callback) const {
+	scheduler.parallelFor(0, sortedIndices.size(), 4096, [&](std::size_t begin, std::size_t end) {
+		forEachNeighbourPairInSlots(begin, end, radius, callback);
+	});
+}
+
+template <typename Callback>
+void SpatialHash::forEachNeighbourPairInSlots(std::size_t slotBegin, std::size_t slotEnd, float radius, Callback&& callback) const {
+	const float radius_sq = radius * radius;
+	const std::uint32_t end_slot = static_cast<std::uint32_t>(slotEnd);
+	SlotRange ranges[kMaxQueryRanges];
+
+	for (std::uint32_t slot = static_cast<std::uint32_t>(slotBegin); slot < end_slot; ++slot) {
+		const float px = sortedX[slot];
+		const float py = sortedY[slot];
+		const int range_count = gatherSlotRanges(px, py, radius, ranges);
+
+		for (int r = 0; r < range_count; ++r) {
+			const std::uint32_t end = ranges[r].end;
+
+			// Only look at later slots so every pair is reported once
+			std::uint32_t other = ranges[r].begin;
+			if (other <= slot) other = slot + 1;
+
+			for (; other < end; ++other) {
+				const float dx = sortedX[other] - px;
+				const float dy = sortedY[other] - py;
+				if (dx * dx + dy * dy < radius_sq) {
+					callback(sortedIndices[slot], sortedIndices[other]);
+				}
+			}
+		}
+	}
+}
+
+template <typename Callback>
+void SpatialHash::forEachNeighbour(float px, float py, float radius, Callback&& callback) const {
+	const float radius_sq = radius * radius;
+	SlotRange ranges[kMaxQueryRanges];
+	const int range_count = gatherSlotRanges(px, py, radius, ranges);
+
+	for (int r = 0; r < range_count; ++r) {
+		for (std::uint32_t slot = ranges[r].begin; slot < ranges[r].end; ++slot) {
+			const float dx = sortedX[slot] - px;
+			const float dy = sortedY[slot] - py;
+			if (dx * dx + dy * dy < radius_sq) {
+				callback(sortedIndices[slot]);
+			}
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+
+// Draw call counters of a SpriteBatch, since the last resetStats()
+struct SpriteBatchStats {
+	unsigned int draw_calls = 0; // batched draws plus drawables drawn directly
+	unsigned int vertices = 0;
+	unsigned int quads = 0;      // sprites and rectangles that went into a batch
+};
+
+// Collects sprites and rectangles as textured quads in one sf::VertexArray and draws
+// them with as few draw calls as possible:
+//
+//     batch.draw(sprite_background);
+//     for (auto& ball : balls) batch.draw(ball_sprite); // all balls: one draw call
+//     batch.draw(window, status_text);                  // text can't be batched
+//     batch.flush(window);
+//
+// Drawing order is kept: quads that follow each other with the same texture and blend
+// mode share a draw call, and a change of texture starts a new one. Anything that isn't
+// a plain sprite or rectangle (text, convex shapes, ...) goes through draw(target,
+// drawable), which flushes the queued quads first.
+class SpriteBatch {
+	public:
+		SpriteBatch();
+
+		void draw(const sf::Sprite& sprite, const sf::BlendMode& blend = sf::BlendAlpha);
+
+		// Fill only, outlines are not drawn
+		void draw(const sf::RectangleShape& rect, const sf::BlendMode& blend = sf::BlendAlpha);
+
+		// Quad with corners in clockwise order from the top left, and the matching texture
+		// rectangle in pixels (texture may be nullptr for a plain colored quad)
+		void drawQuad(const sf::Texture* texture, const sf::Vector2f corners[4], const sf::FloatRect& textureRect,
+			const sf::Color& color, const sf::BlendMode& blend = sf::BlendAlpha);
+
+		// Flushes the queued quads, then draws "drawable" directly
+		void draw(sf::RenderTarget& target, const sf::Drawable& drawable,
+			const sf::RenderStates& states = sf::RenderStates::Default);
+
+		// Draws every queued quad and empties the queue
+		void flush(sf::RenderTarget& target);
+
+		const SpriteBatchStats& getStats() const { return stats; }
+		void resetStats() { stats = SpriteBatchStats(); }
+
+	private:
+		// A run of quads that share texture and blend mode
+		struct Batch {
+			const sf::Texture* texture;
+			sf::BlendMode blend;
+			std::size_t first_vertex;
+			std::size_t vertex_count;
+		};
+
+		sf::VertexArray vertices;
+		std::vector<Batch> batches;
+		SpriteBatchStats stats;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Lock-free ring buffer for exactly one producer thread and one consumer thread.
+//
+// The producer only writes "tail" and the consumer only writes "head", so neither
+// side ever waits for the other: tryPush fails (instead of blocking) when the
+// buffer is full, and tryPop/popBulk return nothing when it is empty.
+// The two indices sit on separate cache lines so the threads don't fight over one.
+template <typename T>
+class SpscRingBuffer {
+	static_assert(std::is_trivially_copyable<T>::value, "SpscRingBuffer holds plain values");
+
+	public:
+		// capacity is rounded up to a power of two
+		explicit SpscRingBuffer(std::size_t capacity) {
+			std::size_t size = 2;
+			while (size < capacity) size <<= 1;
+			mask = size - 1;
+			slots.reset(new T[size]);
+		}
+
+		SpscRingBuffer(const SpscRingBuffer&) = delete;
+		SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+		std::size_t capacity() const { return mask + 1; }
+
+		// Producer side. Returns false if the buffer is full.
+		bool tryPush(const T& value) {
+			const std::size_t t = tail.load(std::memory_order_relaxed);
+			if (t - head.load(std::memory_order_acquire) > mask) {
+				return false;
+			}
+			slots[t & mask] = value;
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer side. Returns false if the buffer is empty.
+		bool tryPop(T& value) {
+			return popBulk(&value, 1) == 1;
+		}
+
+		// Consumer side. Moves up to maxCount values into "out" and returns how many.
+		std::size_t popBulk(T* out, std::size_t maxCount) {
+			const std::size_t h = head.load(std::memory_order_relaxed);
+			std::size_t available = tail.load(std::memory_order_acquire) - h;
+			std::size_t count = available < maxCount ? available : maxCount;
+			for (std::size_t i = 0; i < count; ++i) {
+				out[i] = slots[(h + i) & mask];
+			}
+			head.store(h + count, std::memory_order_release);
+			return count;
+		}
+
+		// Approximate when called while the other side is running
+		std::size_t size() const {
+			return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+		}
+
+	private:
+		std::unique_ptr<T[]> slots;
+		std::size_t mask;
+
+		alignas(64) std::atomic<std::size_t> head{ 0 }; // next slot to read (consumer)
+		alignas(64) std::atomic<std::size_t> tail{ 0 }; // next slot to write (producer)
+};
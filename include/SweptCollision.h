@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Vec2.h"
+
+// Continuous ("swept") collision tests.
+//
+// Instead of only checking where a body is at the end of a step, these test the
+// whole segment it moved along during the step:
+//     p(t) = p0 + (p1 - p0) * t,   t in [0, 1]
+// so a fast body can't jump over a small target between two steps.
+// On a hit, "toi" (time of impact) is the fraction of the step where it happens.
+
+// Does the segment touch the inside of the circle? (toi = 0 if p0 is already inside)
+bool sweepSegmentCircle(const Vec2f& p0, const Vec2f& p1,
+	const Vec2f& center, float radius, float& toi);
+
+// Does the segment enter the box [boxMin, boxMax]? (toi = 0 if p0 is already inside)
+bool sweepSegmentAABB(const Vec2f& p0, const Vec2f& p1,
+	const Vec2f& boxMin, const Vec2f& boxMax, float& toi);
+
+// Does the segment leave the box [boxMin, boxMax]? (toi = 0 if p0 is already outside)
+bool sweepSegmentExitAABB(const Vec2f& p0, const Vec2f& p1,
+	const Vec2f& boxMin, const Vec2f& boxMax, float& toi);
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class TaskScheduler;
+
+// A group of tasks that can be waited on together:
+//
+//     TaskGroup group(scheduler);
+//     group.run([] { ... });
+//     group.run([] { ... });
+//     group.wait(); // the waiting thread helps run tasks until the group is done
+class TaskGroup {
+	public:
+		explicit TaskGroup(TaskScheduler& scheduler);
+		~TaskGroup();
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		void run(std::function<void()> task);
+		void wait();
+
+	private:
+		friend class TaskScheduler;
+
+		TaskScheduler& scheduler;
+		std::atomic<int> pending{ 0 };
+};
+
+// Work-stealing task scheduler.
+//
+// Every worker thread owns a queue. A worker pushes and pops its own tasks at the
+// back (newest first, still hot in cache) and, when it runs dry, steals the
+// oldest task from the front of another worker's queue. Threads that wait on a
+// TaskGroup run tasks too, so a scheduler with threadCount = 1 simply runs
+// everything on the calling thread.
+class TaskScheduler {
+	public:
+		// threadCount = threads that do work, including the one calling wait()/parallelFor
+		// (0 = one per hardware thread)
+		explicit TaskScheduler(unsigned int threadCount = 0);
+		~TaskScheduler();
+
+		TaskScheduler(const TaskScheduler&) = delete;
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+		unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+		// Calls fn(chunkBegin, chunkEnd) over [begin, end) split into chunks of about "grain"
+		// items, in parallel, and returns once every chunk is done. No heap allocations.
+		template <typename Fn>
+		void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn);
+
+		// Process-wide scheduler using every hardware thread
+		static TaskScheduler& getDefault();
+
+	private:
+		friend class TaskGroup;
+
+		// A unit of work: either a range of a parallelFor or a TaskGroup::run task
+		struct Task {
+			void (*invoke)(void* context, std::size_t begin, std::size_t end);
+			void* context;
+			std::size_t begin;
+			std::size_t end;
+			TaskGroup* group;
+		};
+
+		// One worker's queue (a growable ring buffer; it never shrinks, so a warmed-up
+		// scheduler does not allocate)
+		struct WorkQueue {
+			std::mutex mutex;
+			std::vector<Task> ring;
+			std::size_t head = 0;
+			std::size_t count = 0;
+
+			void pushBack(const Task& task);
+			bool popBack(Task& task);
+			bool popFront(Task& task);
+		};
+
+		void submit(const Task& task);
+		bool tryRunOne(int preferredQueue);
+		void execute(const Task& task);
+		void workerLoop(int index);
+
+		template <typename Fn>
+		static void invokeRange(void* context, std::size_t begin, std::size_t end) {
+			(*static_cast<Fn*>(context))(begin, end);
+		}
+
+		std::vector<std::thread> workers;
+		std::unique_ptr<WorkQueue[]> queues;   // one per worker, plus one more when there are no workers
+		std::size_t queueCount = 0;
+
+		std::atomic<int> queuedTasks{ 0 };     // tasks sitting in any queue
+		std::atomic<unsigned int> nextQueue{ 0 };
+		std::atomic<bool> stopping{ false };
+		std::mutex sleepMutex;
+		std::condition_variable wakeUp;
+};
+
+template <typename Fn>
+void TaskScheduler::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn) {
+	if (end <= begin) return;
+	if (grain == 0) grain = 1;
+
+	const std::size_t total = end - begin;
+	if (total <= grain || workers.empty()) {
+		fn(begin, end);
+		return;
+	}
+
+	// Enough chunks to balance the load, but not so many that scheduling dominates
+	std::size_t chunks = (total + grain - 1) / grain;
+	const std::size_t max_chunks = static_cast<std::size_t>(getThreadCount()) * 8;
+	if (chunks > max_chunks) chunks = max_chunks;
+	const std::size_t chunk_size = (total + chunks - 1) / chunks;
+
+	using FnType = typename std::remove_reference<Fn>::type;
+	TaskGroup group(*this);
+	for (std::size_t chunk_begin = begin; chunk_begin < end; chunk_begin += chunk_size) {
+		std::size_t chunk_end = chunk_begin + chunk_size < end ? chunk_begin + chunk_size : end;
+		group.pending.fetch_add(1, std::memory_order_relaxed);
+		submit({ &invokeRange<FnType>, const_cast<void*>(static_cast<const void*>(&fn)), chunk_begin, chunk_end, &group });
+	}
+	group.wait();
+}
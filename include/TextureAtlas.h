@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Packs several images into one texture, so everything drawn from it can share a
+// SpriteBatch draw call:
+//
+//     TextureAtlas atlas;
+//     atlas.addFile("ball", "imgs/ball.png");
+//     atlas.addFile("cart", "imgs/cart.png");
+//     if (!atlas.build(error, "cache/projectile")) { ... }
+//     sf::Sprite ball = atlas.makeSprite("ball");
+//
+// With a cache path, build() saves the packed texture as <cache>.png plus a manifest
+// (<cache>.atlas), and later runs load that instead of packing again as long as the
+// source files keep their size and modification time.
+class TextureAtlas {
+	public:
+		// Queues an image file under "name"; the file is read by build()
+		void addFile(const std::string& name, const std::string& path);
+
+		bool build(std::string& error, const std::string& cachePath = "");
+
+		const sf::Texture& getTexture() const { return texture; }
+
+		// Where "name" sits in the texture, in pixels (empty if there's no such image)
+		sf::IntRect getRect(const std::string& name) const;
+
+		sf::Sprite makeSprite(const std::string& name) const;
+
+	private:
+		struct Source {
+			std::string name;
+			std::string path;
+		};
+
+		bool pack(sf::Image& image, std::string& error);
+		bool loadCache(const std::string& cachePath);
+		void saveCache(const std::string& cachePath, const sf::Image& image) const;
+
+		std::vector<Source> sources;
+		std::map<std::string, sf::IntRect> rects;
+		sf::Texture texture;
+};
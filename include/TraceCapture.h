@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Captures timed zones from any thread into a Chrome Trace Event JSON file, which can be
+// opened in chrome://tracing or https://ui.perfetto.dev:
+//
+//     startTraceCapture("run.json", error);
+//     {
+//         TraceZone zone("Load assets"); // one event from here to the end of the scope
+//         ...
+//     }
+//     stopTraceCapture();
+//
+// Each thread records into its own lock-free buffer, and a background thread turns the
+// events into JSON, so recording a zone costs two clock reads and a buffer write.
+// Zones on the same thread that sit inside each other show up nested in the viewer.
+// When nothing is being captured a zone costs one atomic load.
+
+namespace trace_detail {
+	extern std::atomic<bool> capturing;
+}
+
+inline bool isTraceCapturing() {
+	return trace_detail::capturing.load(std::memory_order_relaxed);
+}
+
+// Nanoseconds on the steady clock (the same clock FrameProfiler uses)
+inline std::int64_t getTraceTime() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Starts writing events to "path". Fails if a capture is already running or the file
+// can't be created.
+bool startTraceCapture(const std::string& path, std::string& error);
+
+// Writes the remaining events, closes the file and returns how many events were
+// dropped because a thread's buffer was full (0 when every event made it)
+std::uint64_t stopTraceCapture();
+
+// Records one zone. "name" must stay valid until the capture stops (a string literal
+// or a FrameProfiler zone name).
+void recordTraceEvent(const char* name, std::int64_t startNs, std::int64_t endNs);
+
+// Names the calling thread in the trace (e.g. "Worker 2")
+void setTraceThreadName(const std::string& name);
+
+// Records the time from construction to the end of the scope
+class TraceZone {
+	public:
+		explicit TraceZone(const char* name) : name(name), start_ns(isTraceCapturing() ? getTraceTime() : -1) {
+		}
+
+		~TraceZone() {
+			if (start_ns >= 0) {
+				recordTraceEvent(name, start_ns, getTraceTime());
+			}
+		}
+
+		TraceZone(const TraceZone&) = delete;
+		TraceZone& operator=(const TraceZone&) = delete;
+
+	private:
+		const char* name;
+		std::int64_t start_ns;
+};
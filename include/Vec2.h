@@ -0,0 +1,29 @@
+#pragma once
+
+// Vec2f is the physics core's own 2d vector, so the core doesn't need any SFML
+// headers. It works like sf::Vector2f (public x and y, the same operators);
+// SfmlAdapters.h converts between the two in the SFML front end.
+struct Vec2f {
+	float x = 0.f;
+	float y = 0.f;
+
+	constexpr Vec2f() = default;
+	constexpr Vec2f(float x, float y) : x(x), y(y) {}
+
+	constexpr Vec2f& operator+=(const Vec2f& other) { x += other.x; y += other.y; return *this; }
+	constexpr Vec2f& operator-=(const Vec2f& other) { x -= other.x; y -= other.y; return *this; }
+	constexpr Vec2f& operator*=(float scale) { x *= scale; y *= scale; return *this; }
+	constexpr Vec2f& operator/=(float scale) { x /= scale; y /= scale; return *this; }
+};
+
+constexpr Vec2f operator-(const Vec2f& v) { return Vec2f(-v.x, -v.y); }
+constexpr Vec2f operator+(const Vec2f& a, const Vec2f& b) { return Vec2f(a.x + b.x, a.y + b.y); }
+constexpr Vec2f operator-(const Vec2f& a, const Vec2f& b) { return Vec2f(a.x - b.x, a.y - b.y); }
+constexpr Vec2f operator*(const Vec2f& v, float scale) { return Vec2f(v.x * scale, v.y * scale); }
+constexpr Vec2f operator*(float scale, const Vec2f& v) { return Vec2f(v.x * scale, v.y * scale); }
+constexpr Vec2f operator/(const Vec2f& v, float scale) { return Vec2f(v.x / scale, v.y / scale); }
+constexpr bool operator==(const Vec2f& a, const Vec2f& b) { return a.x == b.x && a.y == b.y; }
+constexpr bool operator!=(const Vec2f& a, const Vec2f& b) { return !(a == b); }
+
+// Dot product: a.x * b.x + a.y * b.y
+constexpr float dot(const Vec2f& a, const Vec2f& b) { return a.x * b.x + a.y * b.y; }
@@ -0,0 +1,124 @@
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Plain integers, so the counters need no constructor and can be used from the very
+// first allocation of every thread (including the runtime's own startup allocations)
+static thread_local std::uint64_t thread_count = 0;
+static thread_local std::uint64_t thread_bytes = 0;
+static std::atomic<std::uint64_t> total_count{ 0 };
+static std::atomic<std::uint64_t> total_bytes{ 0 };
+
+AllocationCounts getThreadAllocations() {
+	AllocationCounts counts;
+	counts.count = thread_count;
+	counts.bytes = thread_bytes;
+	return counts;
+}
+
+AllocationCounts getTotalAllocations() {
+	AllocationCounts counts;
+	counts.count = total_count.load(std::memory_order_relaxed);
+	counts.bytes = total_bytes.load(std::memory_order_relaxed);
+	return counts;
+}
+
+#if PHYSIM_TRACK_ALLOCATIONS
+
+//-------------------------------------------------------------------------------------------------
+// Global operator new / delete
+//
+// Only the plain and the aligned forms are counted; the array, nothrow and sized forms
+// are replaced too so that every allocation goes through them.
+//-------------------------------------------------------------------------------------------------
+static void countAllocation(std::size_t size) {
+	++thread_count;
+	thread_bytes += size;
+	total_count.fetch_add(1, std::memory_order_relaxed);
+	total_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+static void* allocate(std::size_t size) {
+	countAllocation(size);
+	for (;;) {
+		if (void* p = std::malloc(size != 0 ? size : 1)) {
+			return p;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+static void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+	countAllocation(size);
+	const std::size_t align = static_cast<std::size_t>(alignment);
+	for (;;) {
+#ifdef _MSC_VER
+		void* p = _aligned_malloc(size != 0 ? size : 1, align);
+#else
+		// aligned_alloc wants the size to be a multiple of the alignment
+		void* p = std::aligned_alloc(align, ((size != 0 ? size : 1) + align - 1) / align * align);
+#endif
+		if (p) {
+			return p;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+static void freeAligned(void* p) {
+#ifdef _MSC_VER
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try { return allocate(size); }
+	catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try { return allocate(size); }
+	catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	try { return allocateAligned(size, alignment); }
+	catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	try { return allocateAligned(size, alignment); }
+	catch (...) { return nullptr; }
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(p); }
+
+#endif
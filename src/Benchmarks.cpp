@@ -0,0 +1,149 @@
+#include "Benchmarks.h"
+#include "IntegrationKernels.h"
+#include "ParticleSystem.h"
+#include "SpatialHash.h"
+#include "TaskScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Local Helpers
+//-------------------------------------------------------------------------------------------------
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    double secondsSince(BenchClock::time_point start) {
+        return std::chrono::duration<double>(BenchClock::now() - start).count();
+    }
+
+    // Fills "system" with "count" particles spread uniformly over a square whose size
+    // keeps the average number of particles per cell at "per_cell"
+    void fillUniform(ParticleSystem& system, std::size_t count, float cell_size, float per_cell, unsigned int seed) {
+        float side = std::sqrt(static_cast<float>(count) / per_cell) * cell_size;
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(0.f, side);
+        std::uniform_real_distribution<float> vel(-1.f, 1.f);
+
+        system.clear();
+        system.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            system.addParticle(Vec2f(pos(rng), pos(rng)), Vec2f(vel(rng), vel(rng)));
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Benchmarks
+//-------------------------------------------------------------------------------------------------
+void benchmarkIntegrationKernels(std::ostream& out) {
+    const std::size_t count = 1 << 20;
+    const int steps = 100;
+
+    out << "Integration kernels (" << count << " particles, " << steps << " steps)\n";
+    out << "  detected: " << getSimdLevelName(detectSimdLevel()) << "\n";
+
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 };
+    for (SimdLevel level : levels) {
+        if (!isSimdLevelSupported(level)) continue;
+
+        double rate = measureIntegrationThroughput(level, count, steps);
+        bool exact = matchesScalarReference(level);
+        out << "  " << std::left << std::setw(8) << getSimdLevelName(level) << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << rate / 1e6 << " M particles/s"
+            << (exact ? "   bit-exact" : "   MISMATCH") << "\n";
+    }
+}
+
+void benchmarkBroadphaseScaling(std::ostream& out) {
+    const float cell_size = 1.f;
+    const float radius = 1.f;
+    const float per_cell = 4.f;
+    const std::size_t counts[] = { 10000, 30000, 100000, 300000, 1000000 };
+
+    out << "Spatial hash broadphase (" << per_cell << " particles per cell, radius = cell size)\n";
+    out << "  particles    build ms    pairs ms       pairs     ns/particle\n";
+
+    ParticleSystem system;
+    SpatialHash hash(cell_size);
+    for (std::size_t count : counts) {
+        fillUniform(system, count, cell_size, per_cell, 7u);
+        hash.build(system); // warm up allocations
+
+        auto start = BenchClock::now();
+        hash.build(system);
+        double build_s = secondsSince(start);
+
+        std::uint64_t pairs = 0;
+        start = BenchClock::now();
+        hash.forEachNeighbourPair(radius, [&pairs](std::uint32_t, std::uint32_t) { ++pairs; });
+        double query_s = secondsSince(start);
+
+        out << std::fixed << std::setprecision(2)
+            << std::setw(11) << count
+            << std::setw(12) << build_s * 1e3
+            << std::setw(12) << query_s * 1e3
+            << std::setw(12) << pairs
+            << std::setw(16) << (build_s + query_s) * 1e9 / count << "\n";
+    }
+}
+
+void benchmarkThreadScaling(std::ostream& out) {
+    const std::size_t count = 1000000;
+    const int steps = 10;
+    const float dt = 1.f / 240.f;
+    const float cell_size = 1.f;
+
+    unsigned int max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    out << "Thread scaling (" << count << " particles, integrate + broadphase, " << steps << " steps)\n";
+    out << "  threads    ms/step    speedup\n";
+
+    ParticleSystem system;
+    fillUniform(system, count, cell_size, 4.f, 11u);
+    SpatialHash hash(cell_size);
+
+    // 1, 2, 4, ... and the hardware thread count itself
+    std::vector<unsigned int> thread_counts;
+    for (unsigned int threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    double single_thread_s = 0.0;
+    for (unsigned int threads : thread_counts) {
+        TaskScheduler scheduler(threads);
+        std::atomic<std::uint64_t> pairs{ 0 };
+
+        auto runStep = [&]() {
+            system.step(dt, scheduler);
+            hash.build(system);
+            scheduler.parallelFor(0, hash.size(), 4096, [&](std::size_t begin, std::size_t end) {
+                std::uint64_t local = 0;
+                hash.forEachNeighbourPairInSlots(begin, end, cell_size, [&local](std::uint32_t, std::uint32_t) { ++local; });
+                pairs.fetch_add(local, std::memory_order_relaxed);
+            });
+        };
+
+        runStep(); // warm up
+
+        auto start = BenchClock::now();
+        for (int s = 0; s < steps; ++s) {
+            runStep();
+        }
+        double seconds = secondsSince(start) / steps;
+        if (threads == 1) single_thread_s = seconds;
+
+        out << std::fixed << std::setprecision(2)
+            << std::setw(9) << threads
+            << std::setw(11) << seconds * 1e3
+            << std::setw(10) << single_thread_s / seconds << "x\n";
+    }
+}
@@ -0,0 +1,52 @@
+#include "HudText.h"
+
+#include <charconv>
+#include <cstring>
+#include <string>
+
+// Copies as much of "source" as fits between "out" and "end", returns the new end of "out"
+static char* append(char* out, char* end, const char* source) {
+	while (*source != '\0' && out < end) {
+		*out++ = *source++;
+	}
+	return out;
+}
+
+HudText::HudText() : glyphs(std::string(kMaxLength, ' ')) {}
+
+void HudText::setString(const char* chars) {
+	setString(chars, std::strlen(chars));
+}
+
+void HudText::setString(const char* chars, std::size_t length) {
+	if (length > kMaxLength) {
+		length = kMaxLength;
+	}
+	if (length == shown_length && std::memcmp(chars, shown, length) == 0) {
+		return;
+	}
+
+	std::memcpy(shown, chars, length);
+	shown[length] = '\0';
+	shown_length = length;
+
+	// HUD strings are ASCII, which is the same in UTF-32
+	for (std::size_t i = 0; i < length; ++i) {
+		glyphs[i] = static_cast<unsigned char>(chars[i]);
+	}
+	visible = glyphs;
+	visible.erase(length, kMaxLength - length);
+	text.setString(visible);
+}
+
+void HudText::setNumber(const char* prefix, float value, int precision, const char* suffix) {
+	char buffer[kMaxLength];
+	char* const end = buffer + kMaxLength;
+
+	char* out = append(buffer, end, prefix);
+	std::to_chars_result number = std::to_chars(out, end, value, std::chars_format::fixed, precision);
+	if (number.ec == std::errc()) {
+		out = append(number.ptr, end, suffix);
+	}
+	setString(buffer, static_cast<std::size_t>(out - buffer));
+}
@@ -0,0 +1,290 @@
+#include "IntegrationKernels.h"
+#include "AlignedAllocator.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PHYSIM_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define PHYSIM_X86 0
+#endif
+
+// MSVC lets us use any intrinsic in any function. GCC and Clang need the
+// instruction set to be enabled per function instead.
+#if PHYSIM_X86 && !defined(_MSC_VER)
+#define PHYSIM_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PHYSIM_TARGET(isa)
+#endif
+
+// Never let the compiler turn "a * b + c" into a fused multiply-add:
+// the rounding would differ between the scalar and SIMD paths.
+#if defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Kernels
+//-------------------------------------------------------------------------------------------------
+void integrateScalar(const IntegrationBuffers& b, float dt) {
+    for (std::size_t i = 0; i < b.count; ++i) {
+        b.vx[i] = b.vx[i] + b.ax[i] * dt;
+        b.vy[i] = b.vy[i] + b.ay[i] * dt;
+        b.x[i] = b.x[i] + b.vx[i] * dt;
+        b.y[i] = b.y[i] + b.vy[i] * dt;
+        b.ax[i] = 0.f;
+        b.ay[i] = 0.f;
+    }
+}
+
+// Finishes the entries a SIMD loop could not fill a whole register with
+static void integrateTail(const IntegrationBuffers& b, std::size_t first, float dt) {
+    IntegrationBuffers tail = { b.x + first, b.y + first, b.vx + first, b.vy + first,
+        b.ax + first, b.ay + first, b.count - first };
+    integrateScalar(tail, dt);
+}
+
+#if PHYSIM_X86
+PHYSIM_TARGET("sse2")
+static void integrateSSE2(const IntegrationBuffers& b, float dt) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 zero = _mm_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 4 <= b.count; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(b.vx + i), _mm_mul_ps(_mm_loadu_ps(b.ax + i), vdt));
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(b.vy + i), _mm_mul_ps(_mm_loadu_ps(b.ay + i), vdt));
+        _mm_storeu_ps(b.vx + i, vx);
+        _mm_storeu_ps(b.vy + i, vy);
+        _mm_storeu_ps(b.x + i, _mm_add_ps(_mm_loadu_ps(b.x + i), _mm_mul_ps(vx, vdt)));
+        _mm_storeu_ps(b.y + i, _mm_add_ps(_mm_loadu_ps(b.y + i), _mm_mul_ps(vy, vdt)));
+        _mm_storeu_ps(b.ax + i, zero);
+        _mm_storeu_ps(b.ay + i, zero);
+    }
+    integrateTail(b, i, dt);
+}
+
+PHYSIM_TARGET("avx2")
+static void integrateAVX2(const IntegrationBuffers& b, float dt) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 zero = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= b.count; i += 8) {
+        __m256 vx = _mm256_add_ps(_mm256_loadu_ps(b.vx + i), _mm256_mul_ps(_mm256_loadu_ps(b.ax + i), vdt));
+        __m256 vy = _mm256_add_ps(_mm256_loadu_ps(b.vy + i), _mm256_mul_ps(_mm256_loadu_ps(b.ay + i), vdt));
+        _mm256_storeu_ps(b.vx + i, vx);
+        _mm256_storeu_ps(b.vy + i, vy);
+        _mm256_storeu_ps(b.x + i, _mm256_add_ps(_mm256_loadu_ps(b.x + i), _mm256_mul_ps(vx, vdt)));
+        _mm256_storeu_ps(b.y + i, _mm256_add_ps(_mm256_loadu_ps(b.y + i), _mm256_mul_ps(vy, vdt)));
+        _mm256_storeu_ps(b.ax + i, zero);
+        _mm256_storeu_ps(b.ay + i, zero);
+    }
+    _mm256_zeroupper();
+    integrateTail(b, i, dt);
+}
+
+PHYSIM_TARGET("avx512f")
+static void integrateAVX512(const IntegrationBuffers& b, float dt) {
+    const __m512 vdt = _mm512_set1_ps(dt);
+    const __m512 zero = _mm512_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 16 <= b.count; i += 16) {
+        __m512 vx = _mm512_add_ps(_mm512_loadu_ps(b.vx + i), _mm512_mul_ps(_mm512_loadu_ps(b.ax + i), vdt));
+        __m512 vy = _mm512_add_ps(_mm512_loadu_ps(b.vy + i), _mm512_mul_ps(_mm512_loadu_ps(b.ay + i), vdt));
+        _mm512_storeu_ps(b.vx + i, vx);
+        _mm512_storeu_ps(b.vy + i, vy);
+        _mm512_storeu_ps(b.x + i, _mm512_add_ps(_mm512_loadu_ps(b.x + i), _mm512_mul_ps(vx, vdt)));
+        _mm512_storeu_ps(b.y + i, _mm512_add_ps(_mm512_loadu_ps(b.y + i), _mm512_mul_ps(vy, vdt)));
+        _mm512_storeu_ps(b.ax + i, zero);
+        _mm512_storeu_ps(b.ay + i, zero);
+    }
+    integrateTail(b, i, dt);
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// CPU Feature Detection
+//-------------------------------------------------------------------------------------------------
+#if PHYSIM_X86
+static void cpuid(int leaf, int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, leaf, subleaf);
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned int>(info[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Which register states the OS saves on a context switch (XCR0)
+static unsigned long long readXcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+SimdLevel detectSimdLevel() {
+#if PHYSIM_X86
+    unsigned int regs[4];
+    cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+
+    cpuid(1, 0, regs);
+    const bool has_sse2 = (regs[3] & (1u << 26)) != 0;
+    const bool has_osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool has_avx = (regs[2] & (1u << 28)) != 0;
+    if (!has_sse2) return SimdLevel::Scalar;
+    if (!has_osxsave || !has_avx || max_leaf < 7) return SimdLevel::SSE2;
+
+    const unsigned long long xcr0 = readXcr0();
+    const bool os_ymm = (xcr0 & 0x6) == 0x6;     // SSE + AVX state
+    const bool os_zmm = (xcr0 & 0xE6) == 0xE6;   // plus opmask and upper ZMM state
+
+    cpuid(7, 0, regs);
+    const bool has_avx2 = (regs[1] & (1u << 5)) != 0;
+    const bool has_avx512f = (regs[1] & (1u << 16)) != 0;
+
+    if (has_avx512f && os_zmm) return SimdLevel::AVX512;
+    if (has_avx2 && os_ymm) return SimdLevel::AVX2;
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+bool isSimdLevelSupported(SimdLevel level) {
+    static const SimdLevel detected = detectSimdLevel();
+    return static_cast<int>(level) <= static_cast<int>(detected);
+}
+
+const char* getSimdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar: return "Scalar";
+    case SimdLevel::SSE2:   return "SSE2";
+    case SimdLevel::AVX2:   return "AVX2";
+    case SimdLevel::AVX512: return "AVX-512";
+    }
+    return "Unknown";
+}
+
+IntegrationKernel getIntegrationKernel(SimdLevel level) {
+    if (!isSimdLevelSupported(level)) return nullptr;
+
+    switch (level) {
+    case SimdLevel::Scalar: return &integrateScalar;
+#if PHYSIM_X86
+    case SimdLevel::SSE2:   return &integrateSSE2;
+    case SimdLevel::AVX2:   return &integrateAVX2;
+    case SimdLevel::AVX512: return &integrateAVX512;
+#else
+    default: break;
+#endif
+    }
+    return nullptr;
+}
+
+IntegrationKernel getBestIntegrationKernel() {
+    static const IntegrationKernel best = getIntegrationKernel(detectSimdLevel());
+    return best;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Verification & Throughput
+//-------------------------------------------------------------------------------------------------
+namespace {
+    // Owns one set of SoA arrays for the self-checks below
+    struct KernelTestData {
+        std::vector<float, AlignedAllocator<float, 64>> x, y, vx, vy, ax, ay;
+
+        explicit KernelTestData(std::size_t count)
+            : x(count), y(count), vx(count), vy(count), ax(count), ay(count) {}
+
+        IntegrationBuffers buffers() {
+            return { x.data(), y.data(), vx.data(), vy.data(), ax.data(), ay.data(), x.size() };
+        }
+
+        void randomize(unsigned int seed) {
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> dist(-100.f, 100.f);
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                x[i] = dist(rng); y[i] = dist(rng);
+                vx[i] = dist(rng); vy[i] = dist(rng);
+                ax[i] = dist(rng); ay[i] = dist(rng);
+            }
+        }
+
+        void reapplyForces(unsigned int seed) {
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> dist(-10.f, 10.f);
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                ax[i] = dist(rng);
+                ay[i] = dist(rng);
+            }
+        }
+    };
+
+    bool sameBits(const std::vector<float, AlignedAllocator<float, 64>>& a,
+        const std::vector<float, AlignedAllocator<float, 64>>& b) {
+        return std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+}
+
+bool matchesScalarReference(SimdLevel level, std::size_t count, int steps) {
+    IntegrationKernel kernel = getIntegrationKernel(level);
+    if (!kernel) return false;
+
+    KernelTestData reference(count);
+    KernelTestData candidate(count);
+    reference.randomize(1234u);
+    candidate.randomize(1234u);
+
+    const float dt = 1.f / 240.f;
+    for (int s = 0; s < steps; ++s) {
+        integrateScalar(reference.buffers(), dt);
+        kernel(candidate.buffers(), dt);
+        reference.reapplyForces(static_cast<unsigned int>(s));
+        candidate.reapplyForces(static_cast<unsigned int>(s));
+    }
+
+    return sameBits(reference.x, candidate.x) && sameBits(reference.y, candidate.y)
+        && sameBits(reference.vx, candidate.vx) && sameBits(reference.vy, candidate.vy);
+}
+
+double measureIntegrationThroughput(SimdLevel level, std::size_t count, int steps) {
+    IntegrationKernel kernel = getIntegrationKernel(level);
+    if (!kernel || count == 0 || steps <= 0) return 0.0;
+
+    KernelTestData data(count);
+    data.randomize(42u);
+    IntegrationBuffers buffers = data.buffers();
+
+    const float dt = 1.f / 240.f;
+    kernel(buffers, dt); // warm up caches and page in the arrays
+
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        kernel(buffers, dt);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    if (seconds <= 0.0) return 0.0;
+    return static_cast<double>(count) * steps / seconds;
+}
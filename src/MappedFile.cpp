@@ -0,0 +1,198 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+#if defined(_WIN32)
+
+//-------------------------------------------------------------------------------------------------
+// Windows
+//-------------------------------------------------------------------------------------------------
+bool MappedFile::open(const std::string& path, Mode mode, std::size_t size) {
+	close();
+	writable = mode != Mode::ReadOnly;
+
+	DWORD access = writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+	DWORD creation = mode == Mode::Create ? CREATE_ALWAYS : OPEN_EXISTING;
+	HANDLE file = CreateFileA(path.c_str(), access, FILE_SHARE_READ, nullptr, creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	file_handle = file;
+
+	if (mode != Mode::Create) {
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size)) {
+			close();
+			return false;
+		}
+		size = static_cast<std::size_t>(file_size.QuadPart);
+	}
+	if (size == 0 || !map(size)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MappedFile::map(std::size_t size) {
+	HANDLE file = static_cast<HANDLE>(file_handle);
+
+	// A writable mapping larger than the file grows the file to "size"
+	ULARGE_INTEGER bytes;
+	bytes.QuadPart = size;
+	HANDLE view_mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+		bytes.HighPart, bytes.LowPart, nullptr);
+	if (!view_mapping) {
+		return false;
+	}
+
+	void* view = MapViewOfFile(view_mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+	if (!view) {
+		CloseHandle(view_mapping);
+		return false;
+	}
+	mapping_handle = view_mapping;
+	mapping = static_cast<std::uint8_t*>(view);
+	mapped_size = size;
+	return true;
+}
+
+void MappedFile::unmap() {
+	if (mapping) {
+		UnmapViewOfFile(mapping);
+		mapping = nullptr;
+	}
+	if (mapping_handle) {
+		CloseHandle(static_cast<HANDLE>(mapping_handle));
+		mapping_handle = nullptr;
+	}
+	mapped_size = 0;
+}
+
+bool MappedFile::resize(std::size_t size) {
+	if (!writable || !file_handle || size == 0) {
+		return false;
+	}
+	unmap();
+
+	// Set the exact length first (a mapping can grow a file but never shrink it)
+	HANDLE file = static_cast<HANDLE>(file_handle);
+	LARGE_INTEGER length;
+	length.QuadPart = static_cast<LONGLONG>(size);
+	if (!SetFilePointerEx(file, length, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+		return false;
+	}
+	return map(size);
+}
+
+bool MappedFile::flush() {
+	if (!mapping) return false;
+	return FlushViewOfFile(mapping, 0) && (!writable || FlushFileBuffers(static_cast<HANDLE>(file_handle)));
+}
+
+void MappedFile::close() {
+	unmap();
+	if (file_handle) {
+		CloseHandle(static_cast<HANDLE>(file_handle));
+		file_handle = nullptr;
+	}
+}
+
+#else
+
+//-------------------------------------------------------------------------------------------------
+// POSIX
+//-------------------------------------------------------------------------------------------------
+bool MappedFile::open(const std::string& path, Mode mode, std::size_t size) {
+	close();
+	writable = mode != Mode::ReadOnly;
+
+	int flags = writable ? O_RDWR : O_RDONLY;
+	if (mode == Mode::Create) {
+		flags |= O_CREAT | O_TRUNC;
+	}
+	file_descriptor = ::open(path.c_str(), flags, 0644);
+	if (file_descriptor < 0) {
+		return false;
+	}
+
+	if (mode == Mode::Create) {
+		if (size == 0 || ::ftruncate(file_descriptor, static_cast<off_t>(size)) != 0) {
+			close();
+			return false;
+		}
+	}
+	else {
+		struct stat info;
+		if (::fstat(file_descriptor, &info) != 0) {
+			close();
+			return false;
+		}
+		size = static_cast<std::size_t>(info.st_size);
+	}
+
+	if (size == 0 || !map(size)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MappedFile::map(std::size_t size) {
+	int protection = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+	void* view = ::mmap(nullptr, size, protection, MAP_SHARED, file_descriptor, 0);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+	mapping = static_cast<std::uint8_t*>(view);
+	mapped_size = size;
+	return true;
+}
+
+void MappedFile::unmap() {
+	if (mapping) {
+		::munmap(mapping, mapped_size);
+		mapping = nullptr;
+	}
+	mapped_size = 0;
+}
+
+bool MappedFile::resize(std::size_t size) {
+	if (!writable || file_descriptor < 0 || size == 0) {
+		return false;
+	}
+	unmap();
+	if (::ftruncate(file_descriptor, static_cast<off_t>(size)) != 0) {
+		return false;
+	}
+	return map(size);
+}
+
+bool MappedFile::flush() {
+	if (!mapping) return false;
+	return ::msync(mapping, mapped_size, MS_SYNC) == 0;
+}
+
+void MappedFile::close() {
+	unmap();
+	if (file_descriptor >= 0) {
+		::close(file_descriptor);
+		file_descriptor = -1;
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "Main.h"
+#include "SimulationRegistry.h"
+#include <iostream>
+#include <memory>
+#include <utility>
+
+MenuScene::MenuScene(SceneStack& stack, const sf::Font& font, SimulationRegistry& registry, SessionRecorder* recorder)
+    : stack(stack), font(font), registry(registry), recorder(recorder)
+{
+    simTopicsMenuItems = registry.getTopics();
+    showMenu(AppState::MainMenu, mainMenuItems);
+}
+
+void MenuScene::showMenu(AppState state, std::vector<std::string>& items) {
+    currentState = state;
+    currentMenuItems = &items;
+    currentTextObjects = createMenuTextObj(items, font, textColor);
+    currentMenuBox = positionMenuAndCreateBox(currentTextObjects, stack.getWindow(), highlightColor);
+    selectedItem = 0;
+    if (!items.empty()) {
+        select(0);
+    }
+}
+
+void MenuScene::showSimulations(const std::string& topic) {
+    simulations = registry.getSimulations(topic);
+    simulationsMenuItems.clear();
+    for (const SimulationInfo* info : simulations) {
+        simulationsMenuItems.push_back(info->name);
+    }
+    showMenu(AppState::SimulationsMenu, simulationsMenuItems);
+}
+
+void MenuScene::select(int item) {
+    currentTextObjects[selectedItem].setFillColor(textColor);
+    selectedItem = item;
+    currentTextObjects[selectedItem].setFillColor(highlightColor);
+
+    // Start loading the highlighted simulation's assets, so choosing it doesn't wait on the disk
+    if (currentState == AppState::SimulationsMenu) {
+        registry.prefetch(*simulations[selectedItem]);
+    }
+}
+
+void MenuScene::handleEvent(const sf::Event& event) {
+    if (event.type != sf::Event::KeyPressed) {
+        return;
+    }
+    stack.invalidate();
+
+    if (currentMenuItems->empty() && event.key.code != sf::Keyboard::Escape) {
+        return;
+    }
+    if (event.key.code == sf::Keyboard::Up) {
+        select((selectedItem - 1 + (int)currentMenuItems->size()) % (int)currentMenuItems->size());
+    }
+    else if (event.key.code == sf::Keyboard::Down) {
+        select((selectedItem + 1) % (int)currentMenuItems->size());
+    }
+    else if (event.key.code == sf::Keyboard::Enter) {
+        std::string chosen = (*currentMenuItems)[selectedItem];
+
+        if (currentState == AppState::MainMenu) {
+            if (chosen == "Simulate") {
+                showMenu(AppState::SimTopicsMenu, simTopicsMenuItems);
+            }
+            else if (chosen == "Quit") {
+                stack.getWindow().close();
+            }
+        }
+        else if (currentState == AppState::SimTopicsMenu) {
+            showSimulations(chosen);
+        }
+        else if (currentState == AppState::SimulationsMenu) {
+            // Runs on top of the menu in the same window; Escape comes back here
+            std::string error;
+            std::unique_ptr<Scene> scene = registry.createScene(*simulations[selectedItem], stack, recorder, error);
+            if (scene) {
+                stack.push(std::move(scene));
+            }
+            else {
+                std::cerr << "Error: " << error << "\n";
+            }
+        }
+    }
+    else if (event.key.code == sf::Keyboard::Escape) {
+        if (currentState == AppState::SimulationsMenu) {
+            showMenu(AppState::SimTopicsMenu, simTopicsMenuItems);
+        }
+        else if (currentState == AppState::SimTopicsMenu) {
+            showMenu(AppState::MainMenu, mainMenuItems);
+        }
+        else if (currentState == AppState::MainMenu) {
+            stack.getWindow().close();
+        }
+    }
+}
+
+void MenuScene::update(float /*frameTime*/) {
+    // Nothing moves; the menu only changes on key presses
+}
+
+void MenuScene::draw(sf::RenderWindow& window, SpriteBatch& batch) {
+    batch.draw(window, currentMenuBox);
+    for (auto& t : currentTextObjects) {
+        batch.draw(window, t);
+    }
+}
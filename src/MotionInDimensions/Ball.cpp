@@ -1,43 +1,81 @@
 #include "Ball.h"
+#include "SweptCollision.h"
 #include <cmath>
 
-Ball::Ball(float x_m, float y_m, float speed_m_s, float angle_degrees, float gravity, float scale)
-    : x_m(x_m), y_m(y_m), g(gravity), scale(scale)
+Ball::Ball(float x_m, float y_m, float speed_m_s, float angle_degrees, float gravity)
+    : state(makeBallState(x_m, y_m, speed_m_s, angle_degrees)), g(gravity)
 {
-    float angle_rad = angle_degrees * 3.14159f / 180.f;
-    vx_m_s = speed_m_s * std::cos(angle_rad);
-    vy_m_s = -speed_m_s * std::sin(angle_rad); // negative for upward initial motion
 }
 
 void Ball::update(float dt) {
-    // Update velocities
-    vy_m_s += g * dt;
-
-    // Update positions
-    x_m += vx_m_s * dt;
-    y_m += vy_m_s * dt;
-
-    // Update sprite position
-    sprite.setPosition(x_m * scale, y_m * scale);
-}
-
-void Ball::draw(sf::RenderWindow& window) {
-    window.draw(sprite);
+    // Semi-implicit Euler: update velocities, then positions
+    step<SemiImplicitEuler>(dt);
 }
 
 bool Ball::isScored(float basketX_m, float basketY_m, float threshold_m) const {
-    float dx = x_m - basketX_m;
-    float dy = y_m - basketY_m;
+    float dx = state.x_m - basketX_m;
+    float dy = state.y_m - basketY_m;
     float dist = std::sqrt(dx * dx + dy * dy);
     return dist < threshold_m;
 }
 
 bool Ball::isOutOfBounds(float maxX_m, float maxY_m) const {
     // If the ball goes beyond any boundary, consider it out of bounds.
-    return (x_m < 0.f || x_m > maxX_m || y_m < 0.f || y_m > maxY_m);
+    return (state.x_m < 0.f || state.x_m > maxX_m || state.y_m < 0.f || state.y_m > maxY_m);
+}
+
+bool Ball::isScoredSwept(float basketX_m, float basketY_m, float threshold_m, float& toi) const {
+    return sweepSegmentCircle(Vec2f(state.prev_x_m, state.prev_y_m), Vec2f(state.x_m, state.y_m),
+        Vec2f(basketX_m, basketY_m), threshold_m, toi);
+}
+
+bool Ball::isOutOfBoundsSwept(float maxX_m, float maxY_m, float& toi) const {
+    return sweepSegmentExitAABB(Vec2f(state.prev_x_m, state.prev_y_m), Vec2f(state.x_m, state.y_m),
+        Vec2f(0.f, 0.f), Vec2f(maxX_m, maxY_m), toi);
+}
+
+void Ball::rewindTo(float toi) {
+    state.x_m = state.prev_x_m + (state.x_m - state.prev_x_m) * toi;
+    state.y_m = state.prev_y_m + (state.y_m - state.prev_y_m) * toi;
+}
+
+BallStepResult checkBallStep(float x0, float y0, float x1, float y1, float basketX_m, float basketY_m,
+    float threshold_m, float maxX_m, float maxY_m, float& toi) {
+    // Check the whole path of this step, not just where the ball ended up,
+    // so a fast ball can't pass through the basket between two steps
+    float score_toi = 1.f;
+    float exit_toi = 1.f;
+    bool scored = sweepSegmentCircle(Vec2f(x0, y0), Vec2f(x1, y1), Vec2f(basketX_m, basketY_m), threshold_m, score_toi);
+    bool exited = sweepSegmentExitAABB(Vec2f(x0, y0), Vec2f(x1, y1), Vec2f(0.f, 0.f), Vec2f(maxX_m, maxY_m), exit_toi);
+
+    // Goal scored (ball in basket vicinity) before it left the window
+    if (scored && (!exited || score_toi <= exit_toi)) {
+        toi = score_toi;
+        return BallStepResult::Scored;
+    }
+    // Ball went out of visible bounds
+    if (exited) {
+        toi = exit_toi;
+        return BallStepResult::OutOfBounds;
+    }
+    return BallStepResult::Flying;
+}
+
+BallStepResult Ball::advance(float dt, float basketX_m, float basketY_m, float threshold_m,
+    float maxX_m, float maxY_m) {
+    update(dt);
+
+    float toi = 1.f;
+    BallStepResult result = checkBallStep(state.prev_x_m, state.prev_y_m, state.x_m, state.y_m,
+        basketX_m, basketY_m, threshold_m, maxX_m, maxY_m, toi);
+    if (result != BallStepResult::Flying) {
+        rewindTo(toi);
+    }
+    return result;
 }
 
-void Ball::setSprite(const sf::Sprite& spr) {
-    sprite = spr;
-    sprite.setOrigin(sprite.getTexture()->getSize().x / 2, sprite.getTexture()->getSize().y / 2);  // center
+ProjectileOutcome Ball::predictOutcome(float basketX_m, float basketY_m, float threshold_m,
+    float maxX_m, float maxY_m, float step_dt) const {
+    return solveProjectile(state.x_m, state.y_m, state.vx_m_s, state.vy_m_s, g,
+        basketX_m, basketY_m, threshold_m, maxX_m, maxY_m, step_dt);
 }
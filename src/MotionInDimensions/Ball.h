@@ -2,31 +2,73 @@
 #ifndef BALL_H
 #define BALL_H
 
-#include <SFML/Graphics.hpp>
+#include "BallState.h"
+#include "Integrators.h"
+#include "ProjectileSolver.h"
 
+// What happened during one Ball::advance step
+enum class BallStepResult {
+    Flying,      // still in the air
+    Scored,      // reached the basket (ball rewound to the point of contact)
+    OutOfBounds  // left the window (ball rewound to the edge)
+};
+
+// The end-of-step checks of Ball::advance for a ball that moved from (x0, y0) to (x1, y1):
+// swept basket and window tests, the earlier hit wins. On a hit, toi is the fraction of
+// the step where it happened. Shared with the launch sweep so both score alike.
+BallStepResult checkBallStep(float x0, float y0, float x1, float y1, float basketX_m, float basketY_m,
+    float threshold_m, float maxX_m, float maxY_m, float& toi);
+
+// Physics of the thrown ball. The state itself is a plain BallState; drawing is
+// done separately by BallSprite, which is synced once per displayed frame.
 class Ball {
 	public:
-		Ball(float x_m, float y_m, float speed_m_s, float angle_degrees, float gravity = 9.8f, float scale = 100.f);
+		Ball(float x_m, float y_m, float speed_m_s, float angle_degrees, float gravity = 9.8f);
 
         void update(float dt);
-        void draw(sf::RenderWindow& window);
+
+        // Same as update, but with any integrator policy from Integrators.h,
+        // e.g. ball.step<Yoshida4>(dt)
+        template <typename Integrator>
+        void step(float dt);
+
         bool isScored(float basketX_m, float basketY_m, float threshold_m = 0.2f) const;
         bool isOutOfBounds(float maxX_m, float maxY_m) const;
 
-        // Accessors
-        float getX_m() const { return x_m; }
-        float getY_m() const { return y_m; }
+        // Swept versions: test the whole path moved during the last update instead of
+        // only the end point, so a fast ball can't tunnel through the basket.
+        // toi is the fraction of the step (0..1) where the hit happened.
+        bool isScoredSwept(float basketX_m, float basketY_m, float threshold_m, float& toi) const;
+        bool isOutOfBoundsSwept(float maxX_m, float maxY_m, float& toi) const;
 
-		// setters
-        void setSprite(const sf::Sprite& sprite);
+        // Moves the ball back along the last step (0 = previous position, 1 = current)
+        void rewindTo(float toi);
+
+        // One physics step exactly as the simulation window runs it: update, swept
+        // basket and window tests (the earlier hit wins), then rewind to that hit
+        BallStepResult advance(float dt, float basketX_m, float basketY_m, float threshold_m,
+            float maxX_m, float maxY_m);
+
+        // Closed-form outcome of the rest of this throw (see ProjectileSolver.h)
+        ProjectileOutcome predictOutcome(float basketX_m, float basketY_m, float threshold_m,
+            float maxX_m, float maxY_m, float step_dt = 0.f) const;
+
+        // Accessors
+        const BallState& getState() const { return state; }
+        float getX_m() const { return state.x_m; }
+        float getY_m() const { return state.y_m; }
+        float getVx_m_s() const { return state.vx_m_s; }
+        float getVy_m_s() const { return state.vy_m_s; }
+        float getGravity() const { return g; }
 
     private:
-        float x_m, y_m; // Positiion in meters
-        float vx_m_s, vy_m_s; // Velocity in x and y (m/s)
+        BallState state;
         float g; // Gravity in m/s^2
-        float scale; // Pixels per meter
-
-        sf::Sprite sprite;
 };
 
+template <typename Integrator>
+void Ball::step(float dt) {
+    stepBallState<Integrator>(state, dt, g);
+}
+
 #endif
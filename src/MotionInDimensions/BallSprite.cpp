@@ -0,0 +1,18 @@
+#include "BallSprite.h"
+#include "SfmlAdapters.h"
+
+BallSprite::BallSprite(float scale) : scale(scale) {}
+
+void BallSprite::setSprite(const sf::Sprite& spr) {
+    sprite = spr;
+    sf::FloatRect bounds = sprite.getLocalBounds(); // the sprite's part of the texture
+    sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);  // center
+}
+
+void BallSprite::sync(const BallState& state, float alpha) {
+    sprite.setPosition(toSfml(interpolateBallPosition(state, alpha) * scale));
+}
+
+void BallSprite::draw(SpriteBatch& batch) const {
+    batch.draw(sprite);
+}
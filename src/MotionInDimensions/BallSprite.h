@@ -0,0 +1,32 @@
+#pragma once
+#ifndef BALL_SPRITE_H
+#define BALL_SPRITE_H
+
+#include "BallState.h"
+#include "SpriteBatch.h"
+
+#include <SFML/Graphics.hpp>
+
+// Render-side proxy of a ball. The physics only touches BallState; this copies the
+// interpolated position into the sprite once per displayed frame, so physics
+// substeps never pay for sprite transform updates.
+class BallSprite {
+    public:
+        BallSprite(float scale = 100.f);
+
+        // Uses the texture, scale etc. of "sprite", centered on the ball
+        void setSprite(const sf::Sprite& sprite);
+
+        // Places the sprite between the previous and current physics step:
+        // alpha = 0 is the previous step, alpha = 1 the current one
+        void sync(const BallState& state, float alpha = 1.f);
+
+        // Queues the sprite, so many balls share one draw call
+        void draw(SpriteBatch& batch) const;
+
+    private:
+        sf::Sprite sprite;
+        float scale; // Pixels per meter
+};
+
+#endif
@@ -0,0 +1,15 @@
+#include "BallState.h"
+#include <cmath>
+
+BallState makeBallState(float x_m, float y_m, float speed_m_s, float angle_degrees) {
+    float angle_rad = angle_degrees * 3.14159f / 180.f;
+
+    BallState ball;
+    ball.x_m = x_m;
+    ball.y_m = y_m;
+    ball.prev_x_m = x_m;
+    ball.prev_y_m = y_m;
+    ball.vx_m_s = speed_m_s * std::cos(angle_rad);
+    ball.vy_m_s = -speed_m_s * std::sin(angle_rad); // negative for upward initial motion
+    return ball;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef BALL_STATE_H
+#define BALL_STATE_H
+
+#include "Integrators.h"
+#include "Vec2.h"
+
+#include <type_traits>
+
+// Plain simulation state of one ball: six floats, no rendering data, so large
+// batches of balls stay packed in cache. Coordinates are in meters with +y down.
+struct BallState {
+    float x_m, y_m;           // Position in meters
+    float prev_x_m, prev_y_m; // Position before the last step (for render interpolation)
+    float vx_m_s, vy_m_s;     // Velocity in x and y (m/s)
+};
+
+static_assert(std::is_trivially_copyable<BallState>::value && std::is_standard_layout<BallState>::value,
+    "BallState must stay a plain struct");
+
+// Launch state for a throw at speed_m_s and angle_degrees (0 = right, 90 = straight up)
+BallState makeBallState(float x_m, float y_m, float speed_m_s, float angle_degrees);
+
+// Advances the ball one step under gravity (+y, m/s^2) with any integrator policy
+// from Integrators.h, remembering the previous position for interpolation
+template <typename Integrator>
+void stepBallState(BallState& ball, float dt, float gravity) {
+    ball.prev_x_m = ball.x_m;
+    ball.prev_y_m = ball.y_m;
+
+    // Gravity is the only force, pulling down (+y) at g m/s^2
+    KinematicState<Vec2f> state = { Vec2f(ball.x_m, ball.y_m), Vec2f(ball.vx_m_s, ball.vy_m_s) };
+    Integrator::step(state, dt, [gravity](const Vec2f&, const Vec2f&) {
+        return Vec2f(0.f, gravity);
+    });
+
+    ball.x_m = state.position.x;
+    ball.y_m = state.position.y;
+    ball.vx_m_s = state.velocity.x;
+    ball.vy_m_s = state.velocity.y;
+}
+
+// Position between the previous and current step: alpha = 0 is the previous step, 1 the current one
+inline Vec2f interpolateBallPosition(const BallState& ball, float alpha) {
+    Vec2f prev_m(ball.prev_x_m, ball.prev_y_m);
+    return prev_m + (Vec2f(ball.x_m, ball.y_m) - prev_m) * alpha;
+}
+
+#endif
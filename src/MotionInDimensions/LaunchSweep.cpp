@@ -0,0 +1,671 @@
+#include "LaunchSweep.h"
+#include "AllocationTracker.h"
+#include "Ball.h"
+#include "IntegrationKernels.h"
+#include "TraceCapture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PHYSIM_X86 1
+#include <immintrin.h>
+#else
+#define PHYSIM_X86 0
+#endif
+
+#if PHYSIM_X86 && !defined(_MSC_VER)
+#define PHYSIM_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PHYSIM_TARGET(isa)
+#endif
+
+// Keep multiplies and adds separate so every lane width matches Ball::update bit for bit
+#if defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Launch Sampling
+//-------------------------------------------------------------------------------------------------
+
+// SplitMix64: a counter-based generator, so launch "index" gets the same numbers no matter
+// which thread evaluates it or in what order
+static float uniformSample(std::uint64_t seed, std::uint64_t counter) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ull * (counter + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+    return static_cast<float>(z >> 40) * (1.f / 16777216.f); // 24 random bits -> [0, 1)
+}
+
+static float sampleRange(const SweepRange& range, std::uint64_t seed, std::uint64_t counter) {
+    return range.min + (range.max - range.min) * uniformSample(seed, counter);
+}
+
+ProjectileLaunch sampleLaunch(const LaunchSweepConfig& config, std::size_t index) {
+    const std::uint64_t base = static_cast<std::uint64_t>(index) * 5;
+    ProjectileLaunch launch;
+    launch.speed_m_s = sampleRange(config.speed_m_s, config.seed, base + 0);
+    launch.angle_deg = sampleRange(config.angle_deg, config.seed, base + 1);
+    launch.gravity = sampleRange(config.gravity, config.seed, base + 2);
+    launch.launch_height_m = sampleRange(config.launch_height_m, config.seed, base + 3);
+    launch.cart_distance_m = sampleRange(config.cart_distance_m, config.seed, base + 4);
+    return launch;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Launch State (same start conditions as the Ball constructor)
+//-------------------------------------------------------------------------------------------------
+namespace {
+    struct LaunchStart {
+        float x, y, vx, vy, g_dt;
+        float basket_x, basket_y;
+    };
+
+    LaunchStart makeStart(const ProjectileLaunch& launch, float dt) {
+        ProjectileSetup setup = makeProjectileSetup(launch.launch_height_m, launch.cart_distance_m);
+
+        float angle_rad = launch.angle_deg * 3.14159f / 180.f;
+        LaunchStart start;
+        start.x = setup.start_x_m;
+        start.y = setup.start_y_m;
+        start.vx = launch.speed_m_s * std::cos(angle_rad);
+        start.vy = -launch.speed_m_s * std::sin(angle_rad); // negative for upward initial motion
+        start.g_dt = launch.gravity * dt;
+        start.basket_x = setup.basket_x_m;
+        start.basket_y = setup.basket_y_m;
+        return start;
+    }
+
+    const float kMaxX = kWindowWidth / kScale;
+    const float kMaxY = kWindowHeight / kScale;
+
+    // The scalar stepping loop; on_step(x, y, vx, vy) sees the state after every step
+    // (on the last step, where the ball scored or left the window)
+    template <typename OnStep>
+    LaunchOutcome stepLaunch(const ProjectileLaunch& launch, float dt, int max_steps, int* steps_taken, OnStep&& on_step) {
+        LaunchStart s = makeStart(launch, dt);
+
+        int steps = 0;
+        LaunchOutcome outcome = LaunchOutcome::TimedOut;
+        while (steps < max_steps) {
+            const float prev_x = s.x;
+            const float prev_y = s.y;
+
+            // Ball::update
+            s.vy = s.vy + s.g_dt;
+            s.x = s.x + s.vx * dt;
+            s.y = s.y + s.vy * dt;
+            ++steps;
+
+            // Ball::advance: swept basket and window checks, then rewind to the hit
+            float toi = 1.f;
+            BallStepResult result = checkBallStep(prev_x, prev_y, s.x, s.y, s.basket_x, s.basket_y,
+                kBasketRadius, kMaxX, kMaxY, toi);
+            if (result != BallStepResult::Flying) {
+                s.x = prev_x + (s.x - prev_x) * toi;
+                s.y = prev_y + (s.y - prev_y) * toi;
+            }
+            on_step(s.x, s.y, s.vx, s.vy);
+
+            if (result == BallStepResult::Scored) {
+                outcome = LaunchOutcome::Scored;
+                break;
+            }
+            if (result == BallStepResult::OutOfBounds) {
+                outcome = LaunchOutcome::OutOfBounds;
+                break;
+            }
+        }
+
+        if (steps_taken) *steps_taken = steps;
+        return outcome;
+    }
+}
+
+LaunchOutcome simulateLaunch(const ProjectileLaunch& launch, float dt, int max_steps, int* steps_taken) {
+    return stepLaunch(launch, dt, max_steps, steps_taken, [](float, float, float, float) {});
+}
+
+void LaunchTrace::clear() {
+    t_s.clear();
+    x_m.clear();
+    y_m.clear();
+    vx_m_s.clear();
+    vy_m_s.clear();
+}
+
+LaunchOutcome traceLaunch(const ProjectileLaunch& launch, float dt, int max_steps, LaunchTrace& trace) {
+    trace.clear();
+
+    // Launch state first, then one sample per step
+    LaunchStart start = makeStart(launch, dt);
+    auto record = [&trace, dt](float x, float y, float vx, float vy) {
+        trace.t_s.push_back(static_cast<float>(trace.t_s.size()) * dt);
+        trace.x_m.push_back(x);
+        trace.y_m.push_back(y);
+        trace.vx_m_s.push_back(vx);
+        trace.vy_m_s.push_back(vy);
+    };
+    record(start.x, start.y, start.vx, start.vy);
+    return stepLaunch(launch, dt, max_steps, nullptr, record);
+}
+
+//-------------------------------------------------------------------------------------------------
+// SIMD Lanes
+//
+// A LaneBlock holds W launches side by side. "advance" steps all of them together until
+// any active lane might have scored or left the window on its last step, or "budget" steps
+// have passed, and reports those lanes in event_mask. The lanes only run a cheap filter:
+//     out of the window at either end of the step, or
+//     end point closer to the basket than kBasketRadius + the step's length
+// which every step Ball::advance would stop on passes. sweepChunk then runs the same
+// checkBallStep on the flagged lanes (from prev_x/prev_y to x/y) to get the real outcome.
+//-------------------------------------------------------------------------------------------------
+namespace {
+    // Slack on the score filter, so float rounding can't hide a hit checkBallStep would find
+    const float kScoreMargin = 1e-3f;
+
+    template <int W>
+    struct alignas(64) LaneBlock {
+        float x[W], y[W], vx[W], vy[W], g_dt[W];
+        float prev_x[W], prev_y[W];
+        float basket_x[W], basket_y[W];
+        unsigned int active_mask;
+        unsigned int event_mask;
+    };
+
+    template <int W>
+    using AdvanceFn = int (*)(LaneBlock<W>& lanes, float dt, int budget);
+
+    int advanceScalar(LaneBlock<1>& lanes, float dt, int budget) {
+        LaunchStart s = { lanes.x[0], lanes.y[0], lanes.vx[0], lanes.vy[0], lanes.g_dt[0], lanes.basket_x[0], lanes.basket_y[0] };
+        const bool start_out = s.x < 0.f || s.x > kMaxX || s.y < 0.f || s.y > kMaxY;
+        float prev_x = s.x, prev_y = s.y;
+        lanes.event_mask = 0;
+
+        int steps = 0;
+        while (steps < budget) {
+            prev_x = s.x;
+            prev_y = s.y;
+            const float step_x = s.vx * dt;
+            s.vy = s.vy + s.g_dt;
+            const float step_y = s.vy * dt;
+            s.x = s.x + step_x;
+            s.y = s.y + step_y;
+            ++steps;
+
+            float dx = s.x - s.basket_x;
+            float dy = s.y - s.basket_y;
+            float reach = kBasketRadius + kScoreMargin + std::fabs(step_x) + std::fabs(step_y);
+            bool near = dx * dx + dy * dy < reach * reach;
+            bool out = start_out || s.x < 0.f || s.x > kMaxX || s.y < 0.f || s.y > kMaxY;
+            if ((near || out) && lanes.active_mask) {
+                lanes.event_mask = 1u;
+                break;
+            }
+        }
+
+        lanes.x[0] = s.x;
+        lanes.y[0] = s.y;
+        lanes.vy[0] = s.vy;
+        lanes.prev_x[0] = prev_x;
+        lanes.prev_y[0] = prev_y;
+        return steps;
+    }
+
+#if PHYSIM_X86
+    PHYSIM_TARGET("sse2")
+    int advanceSSE2(LaneBlock<4>& lanes, float dt, int budget) {
+        const __m128 vdt = _mm_set1_ps(dt);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 sign = _mm_set1_ps(-0.f);
+        const __m128 radius = _mm_set1_ps(kBasketRadius + kScoreMargin);
+        const __m128 max_x = _mm_set1_ps(kMaxX);
+        const __m128 max_y = _mm_set1_ps(kMaxY);
+
+        __m128 x = _mm_load_ps(lanes.x), y = _mm_load_ps(lanes.y);
+        __m128 vx = _mm_load_ps(lanes.vx), vy = _mm_load_ps(lanes.vy);
+        __m128 prev_x = x, prev_y = y;
+        const __m128 g_dt = _mm_load_ps(lanes.g_dt);
+        const __m128 bx = _mm_load_ps(lanes.basket_x), by = _mm_load_ps(lanes.basket_y);
+        const __m128 start_out = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, zero), _mm_cmpgt_ps(x, max_x)),
+            _mm_or_ps(_mm_cmplt_ps(y, zero), _mm_cmpgt_ps(y, max_y)));
+
+        int steps = 0;
+        int events = 0;
+        while (steps < budget) {
+            prev_x = x;
+            prev_y = y;
+            const __m128 step_x = _mm_mul_ps(vx, vdt);
+            vy = _mm_add_ps(vy, g_dt);
+            const __m128 step_y = _mm_mul_ps(vy, vdt);
+            x = _mm_add_ps(x, step_x);
+            y = _mm_add_ps(y, step_y);
+            ++steps;
+
+            __m128 dx = _mm_sub_ps(x, bx);
+            __m128 dy = _mm_sub_ps(y, by);
+            __m128 dist2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 reach = _mm_add_ps(radius, _mm_add_ps(_mm_andnot_ps(sign, step_x), _mm_andnot_ps(sign, step_y)));
+            __m128 near = _mm_cmplt_ps(dist2, _mm_mul_ps(reach, reach));
+
+            __m128 out = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, zero), _mm_cmpgt_ps(x, max_x)),
+                _mm_or_ps(_mm_cmplt_ps(y, zero), _mm_cmpgt_ps(y, max_y)));
+            events = _mm_movemask_ps(_mm_or_ps(near, _mm_or_ps(out, start_out))) & lanes.active_mask;
+
+            if (events) break;
+        }
+
+        _mm_store_ps(lanes.x, x);
+        _mm_store_ps(lanes.y, y);
+        _mm_store_ps(lanes.vy, vy);
+        _mm_store_ps(lanes.prev_x, prev_x);
+        _mm_store_ps(lanes.prev_y, prev_y);
+        lanes.event_mask = static_cast<unsigned int>(events);
+        return steps;
+    }
+
+    PHYSIM_TARGET("avx2")
+    int advanceAVX2(LaneBlock<8>& lanes, float dt, int budget) {
+        const __m256 vdt = _mm256_set1_ps(dt);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 sign = _mm256_set1_ps(-0.f);
+        const __m256 radius = _mm256_set1_ps(kBasketRadius + kScoreMargin);
+        const __m256 max_x = _mm256_set1_ps(kMaxX);
+        const __m256 max_y = _mm256_set1_ps(kMaxY);
+
+        __m256 x = _mm256_load_ps(lanes.x), y = _mm256_load_ps(lanes.y);
+        __m256 vx = _mm256_load_ps(lanes.vx), vy = _mm256_load_ps(lanes.vy);
+        __m256 prev_x = x, prev_y = y;
+        const __m256 g_dt = _mm256_load_ps(lanes.g_dt);
+        const __m256 bx = _mm256_load_ps(lanes.basket_x), by = _mm256_load_ps(lanes.basket_y);
+        const __m256 start_out = _mm256_or_ps(
+            _mm256_or_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), _mm256_cmp_ps(x, max_x, _CMP_GT_OQ)),
+            _mm256_or_ps(_mm256_cmp_ps(y, zero, _CMP_LT_OQ), _mm256_cmp_ps(y, max_y, _CMP_GT_OQ)));
+
+        int steps = 0;
+        int events = 0;
+        while (steps < budget) {
+            prev_x = x;
+            prev_y = y;
+            const __m256 step_x = _mm256_mul_ps(vx, vdt);
+            vy = _mm256_add_ps(vy, g_dt);
+            const __m256 step_y = _mm256_mul_ps(vy, vdt);
+            x = _mm256_add_ps(x, step_x);
+            y = _mm256_add_ps(y, step_y);
+            ++steps;
+
+            __m256 dx = _mm256_sub_ps(x, bx);
+            __m256 dy = _mm256_sub_ps(y, by);
+            __m256 dist2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 reach = _mm256_add_ps(radius, _mm256_add_ps(_mm256_andnot_ps(sign, step_x), _mm256_andnot_ps(sign, step_y)));
+            __m256 near = _mm256_cmp_ps(dist2, _mm256_mul_ps(reach, reach), _CMP_LT_OQ);
+
+            __m256 out = _mm256_or_ps(
+                _mm256_or_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), _mm256_cmp_ps(x, max_x, _CMP_GT_OQ)),
+                _mm256_or_ps(_mm256_cmp_ps(y, zero, _CMP_LT_OQ), _mm256_cmp_ps(y, max_y, _CMP_GT_OQ)));
+            events = _mm256_movemask_ps(_mm256_or_ps(near, _mm256_or_ps(out, start_out))) & lanes.active_mask;
+
+            if (events) break;
+        }
+
+        _mm256_store_ps(lanes.x, x);
+        _mm256_store_ps(lanes.y, y);
+        _mm256_store_ps(lanes.vy, vy);
+        _mm256_store_ps(lanes.prev_x, prev_x);
+        _mm256_store_ps(lanes.prev_y, prev_y);
+        _mm256_zeroupper();
+        lanes.event_mask = static_cast<unsigned int>(events);
+        return steps;
+    }
+
+    PHYSIM_TARGET("avx512f")
+    int advanceAVX512(LaneBlock<16>& lanes, float dt, int budget) {
+        const __m512 vdt = _mm512_set1_ps(dt);
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 radius = _mm512_set1_ps(kBasketRadius + kScoreMargin);
+        const __m512 max_x = _mm512_set1_ps(kMaxX);
+        const __m512 max_y = _mm512_set1_ps(kMaxY);
+        const __mmask16 active = static_cast<__mmask16>(lanes.active_mask);
+
+        __m512 x = _mm512_load_ps(lanes.x), y = _mm512_load_ps(lanes.y);
+        __m512 vx = _mm512_load_ps(lanes.vx), vy = _mm512_load_ps(lanes.vy);
+        __m512 prev_x = x, prev_y = y;
+        const __m512 g_dt = _mm512_load_ps(lanes.g_dt);
+        const __m512 bx = _mm512_load_ps(lanes.basket_x), by = _mm512_load_ps(lanes.basket_y);
+        const __mmask16 start_out = static_cast<__mmask16>(
+            _mm512_mask_cmp_ps_mask(active, x, zero, _CMP_LT_OQ) | _mm512_mask_cmp_ps_mask(active, x, max_x, _CMP_GT_OQ)
+            | _mm512_mask_cmp_ps_mask(active, y, zero, _CMP_LT_OQ) | _mm512_mask_cmp_ps_mask(active, y, max_y, _CMP_GT_OQ));
+
+        int steps = 0;
+        __mmask16 events = 0;
+        while (steps < budget) {
+            prev_x = x;
+            prev_y = y;
+            const __m512 step_x = _mm512_mul_ps(vx, vdt);
+            vy = _mm512_add_ps(vy, g_dt);
+            const __m512 step_y = _mm512_mul_ps(vy, vdt);
+            x = _mm512_add_ps(x, step_x);
+            y = _mm512_add_ps(y, step_y);
+            ++steps;
+
+            __m512 dx = _mm512_sub_ps(x, bx);
+            __m512 dy = _mm512_sub_ps(y, by);
+            __m512 dist2 = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+            __m512 reach = _mm512_add_ps(radius, _mm512_add_ps(_mm512_abs_ps(step_x), _mm512_abs_ps(step_y)));
+            __mmask16 near = _mm512_mask_cmp_ps_mask(active, dist2, _mm512_mul_ps(reach, reach), _CMP_LT_OQ);
+
+            __mmask16 out = static_cast<__mmask16>(
+                _mm512_mask_cmp_ps_mask(active, x, zero, _CMP_LT_OQ) | _mm512_mask_cmp_ps_mask(active, x, max_x, _CMP_GT_OQ)
+                | _mm512_mask_cmp_ps_mask(active, y, zero, _CMP_LT_OQ) | _mm512_mask_cmp_ps_mask(active, y, max_y, _CMP_GT_OQ));
+            events = static_cast<__mmask16>(near | out | start_out);
+
+            if (events) break;
+        }
+
+        _mm512_store_ps(lanes.x, x);
+        _mm512_store_ps(lanes.y, y);
+        _mm512_store_ps(lanes.vy, vy);
+        _mm512_store_ps(lanes.prev_x, prev_x);
+        _mm512_store_ps(lanes.prev_y, prev_y);
+        lanes.event_mask = events;
+        return steps;
+    }
+#endif
+
+    //---------------------------------------------------------------------------------------------
+    // Per-chunk statistics (merged once every chunk is done)
+    //---------------------------------------------------------------------------------------------
+    struct ChunkStats {
+        std::size_t hits = 0, out_of_bounds = 0, timeouts = 0;
+        double hit_time_sum = 0.0;
+        double step_sum = 0.0;
+        SweepRange hit_speed_m_s, hit_angle_deg, hit_gravity, hit_launch_height_m, hit_cart_distance_m;
+        std::uint32_t* bin_launches = nullptr;
+        std::uint32_t* bin_hits = nullptr;
+        std::uint64_t allocations = 0;
+    };
+
+    const SweepRange kEmptyRange = { std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+    void widen(SweepRange& range, float value) {
+        range.min = std::min(range.min, value);
+        range.max = std::max(range.max, value);
+    }
+
+    void widen(SweepRange& range, const SweepRange& other) {
+        range.min = std::min(range.min, other.min);
+        range.max = std::max(range.max, other.max);
+    }
+
+    int binOf(const SweepRange& range, float value, int bins) {
+        if (range.max <= range.min) return 0;
+        int bin = static_cast<int>((value - range.min) / (range.max - range.min) * bins);
+        return std::min(std::max(bin, 0), bins - 1);
+    }
+
+    // "toi" is where in the last step the launch ended (see checkBallStep)
+    void recordLaunch(const LaunchSweepConfig& config, std::size_t index, LaunchOutcome outcome, int steps, float toi,
+        ChunkStats& stats) {
+        ProjectileLaunch launch = sampleLaunch(config, index);
+        int bin = binOf(config.angle_deg, launch.angle_deg, config.angle_bins) * config.speed_bins
+            + binOf(config.speed_m_s, launch.speed_m_s, config.speed_bins);
+
+        ++stats.bin_launches[bin];
+        stats.step_sum += steps;
+
+        if (outcome == LaunchOutcome::Scored) {
+            ++stats.hits;
+            ++stats.bin_hits[bin];
+            stats.hit_time_sum += (steps - 1 + static_cast<double>(toi)) * config.dt;
+            widen(stats.hit_speed_m_s, launch.speed_m_s);
+            widen(stats.hit_angle_deg, launch.angle_deg);
+            widen(stats.hit_gravity, launch.gravity);
+            widen(stats.hit_launch_height_m, launch.launch_height_m);
+            widen(stats.hit_cart_distance_m, launch.cart_distance_m);
+        }
+        else if (outcome == LaunchOutcome::OutOfBounds) {
+            ++stats.out_of_bounds;
+        }
+        else {
+            ++stats.timeouts;
+        }
+    }
+
+    // Runs launches [begin, end) through W lanes, refilling a lane as soon as its launch ends
+    template <int W>
+    void sweepChunk(const LaunchSweepConfig& config, std::size_t begin, std::size_t end, AdvanceFn<W> advance, ChunkStats& stats) {
+        LaneBlock<W> lanes;
+        std::size_t lane_launch[W];
+        long long lane_start[W];
+        long long step_count = 0;
+        std::size_t next = begin;
+        lanes.active_mask = 0;
+
+        auto fillLane = [&](int lane) {
+            if (next < end) {
+                LaunchStart s = makeStart(sampleLaunch(config, next), config.dt);
+                lanes.x[lane] = s.x;
+                lanes.y[lane] = s.y;
+                lanes.vx[lane] = s.vx;
+                lanes.vy[lane] = s.vy;
+                lanes.g_dt[lane] = s.g_dt;
+                lanes.basket_x[lane] = s.basket_x;
+                lanes.basket_y[lane] = s.basket_y;
+                lane_launch[lane] = next++;
+                lane_start[lane] = step_count;
+                lanes.active_mask |= 1u << lane;
+            }
+            else {
+                // Park the idle lane somewhere harmless; its results are masked out
+                lanes.x[lane] = lanes.y[lane] = 1.f;
+                lanes.vx[lane] = lanes.vy[lane] = lanes.g_dt[lane] = 0.f;
+                lanes.basket_x[lane] = lanes.basket_y[lane] = -1000.f;
+                lanes.active_mask &= ~(1u << lane);
+            }
+        };
+
+        for (int lane = 0; lane < W; ++lane) {
+            fillLane(lane);
+        }
+
+        while (lanes.active_mask != 0) {
+            // Never run an active lane past its step limit
+            long long budget = 1024;
+            for (int lane = 0; lane < W; ++lane) {
+                if (lanes.active_mask & (1u << lane)) {
+                    budget = std::min(budget, config.max_steps - (step_count - lane_start[lane]));
+                }
+            }
+
+            step_count += advance(lanes, config.dt, static_cast<int>(budget));
+
+            for (int lane = 0; lane < W; ++lane) {
+                const unsigned int bit = 1u << lane;
+                if (!(lanes.active_mask & bit)) continue;
+
+                // The lanes only flag steps that might have ended the launch; check them for real
+                BallStepResult result = BallStepResult::Flying;
+                float toi = 1.f;
+                if (lanes.event_mask & bit) {
+                    result = checkBallStep(lanes.prev_x[lane], lanes.prev_y[lane], lanes.x[lane], lanes.y[lane],
+                        lanes.basket_x[lane], lanes.basket_y[lane], kBasketRadius, kMaxX, kMaxY, toi);
+                }
+
+                const int steps = static_cast<int>(step_count - lane_start[lane]);
+                LaunchOutcome outcome;
+                if (result == BallStepResult::Scored) outcome = LaunchOutcome::Scored;
+                else if (result == BallStepResult::OutOfBounds) outcome = LaunchOutcome::OutOfBounds;
+                else if (steps >= config.max_steps) outcome = LaunchOutcome::TimedOut;
+                else continue;
+
+                recordLaunch(config, lane_launch[lane], outcome, steps, toi, stats);
+                fillLane(lane);
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Function: runLaunchSweep
+//-------------------------------------------------------------------------------------------------
+LaunchSweepResult runLaunchSweep(const LaunchSweepConfig& config, TaskScheduler& scheduler) {
+    TraceZone sweep_zone("Launch sweep");
+    auto start_time = std::chrono::steady_clock::now();
+
+    LaunchSweepResult result;
+    result.launches = config.launches;
+    result.speed_bins = std::max(config.speed_bins, 1);
+    result.angle_bins = std::max(config.angle_bins, 1);
+    const std::size_t bin_count = static_cast<std::size_t>(result.speed_bins) * result.angle_bins;
+
+    LaunchSweepConfig cfg = config;
+    cfg.speed_bins = result.speed_bins;
+    cfg.angle_bins = result.angle_bins;
+
+    // Widest lane width this CPU supports
+    SimdLevel level = detectSimdLevel();
+#if !PHYSIM_X86
+    level = SimdLevel::Scalar;
+#endif
+    result.simd_path = getSimdLevelName(level);
+
+    // Fixed chunks (a few per thread, for load balancing), each with its own counters
+    std::size_t chunk_count = std::min<std::size_t>(std::max<std::size_t>(config.launches / 4096, 1),
+        static_cast<std::size_t>(scheduler.getThreadCount()) * 16);
+    std::vector<ChunkStats> chunks(chunk_count);
+    std::vector<std::uint32_t> chunk_bins(chunk_count * bin_count * 2, 0);
+    for (std::size_t c = 0; c < chunk_count; ++c) {
+        chunks[c].hit_speed_m_s = chunks[c].hit_angle_deg = chunks[c].hit_gravity = kEmptyRange;
+        chunks[c].hit_launch_height_m = chunks[c].hit_cart_distance_m = kEmptyRange;
+        chunks[c].bin_launches = &chunk_bins[c * bin_count * 2];
+        chunks[c].bin_hits = chunks[c].bin_launches + bin_count;
+    }
+
+    scheduler.parallelFor(0, chunk_count, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t c = first; c < last; ++c) {
+            TraceZone chunk_zone("Sweep chunk");
+            const std::uint64_t allocations_before = getThreadAllocations().count;
+            std::size_t begin = config.launches * c / chunk_count;
+            std::size_t end = config.launches * (c + 1) / chunk_count;
+
+            switch (level) {
+#if PHYSIM_X86
+            case SimdLevel::AVX512: sweepChunk<16>(cfg, begin, end, &advanceAVX512, chunks[c]); break;
+            case SimdLevel::AVX2:   sweepChunk<8>(cfg, begin, end, &advanceAVX2, chunks[c]); break;
+            case SimdLevel::SSE2:   sweepChunk<4>(cfg, begin, end, &advanceSSE2, chunks[c]); break;
+#endif
+            default:                sweepChunk<1>(cfg, begin, end, &advanceScalar, chunks[c]); break;
+            }
+            chunks[c].allocations = getThreadAllocations().count - allocations_before;
+        }
+    });
+
+    // Merge the chunks
+    result.bin_launches.assign(bin_count, 0);
+    result.bin_hits.assign(bin_count, 0);
+    SweepRange hit_speed = kEmptyRange, hit_angle = kEmptyRange, hit_gravity = kEmptyRange;
+    SweepRange hit_height = kEmptyRange, hit_distance = kEmptyRange;
+    double hit_time_sum = 0.0, step_sum = 0.0;
+
+    for (const ChunkStats& chunk : chunks) {
+        result.hits += chunk.hits;
+        result.out_of_bounds += chunk.out_of_bounds;
+        result.timeouts += chunk.timeouts;
+        hit_time_sum += chunk.hit_time_sum;
+        step_sum += chunk.step_sum;
+        result.allocations += chunk.allocations;
+        widen(hit_speed, chunk.hit_speed_m_s);
+        widen(hit_angle, chunk.hit_angle_deg);
+        widen(hit_gravity, chunk.hit_gravity);
+        widen(hit_height, chunk.hit_launch_height_m);
+        widen(hit_distance, chunk.hit_cart_distance_m);
+        for (std::size_t b = 0; b < bin_count; ++b) {
+            result.bin_launches[b] += chunk.bin_launches[b];
+            result.bin_hits[b] += chunk.bin_hits[b];
+        }
+    }
+
+    if (result.hits > 0) {
+        result.mean_hit_time_s = hit_time_sum / result.hits;
+        result.hit_speed_m_s = hit_speed;
+        result.hit_angle_deg = hit_angle;
+        result.hit_gravity = hit_gravity;
+        result.hit_launch_height_m = hit_height;
+        result.hit_cart_distance_m = hit_distance;
+    }
+    if (result.launches > 0) {
+        result.mean_steps = step_sum / result.launches;
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    result.launches_per_second = result.seconds > 0.0 ? result.launches / result.seconds : 0.0;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Reports
+//-------------------------------------------------------------------------------------------------
+static void writeRangeLine(std::ostream& out, const char* name, const SweepRange& sampled, const SweepRange& hits, bool any_hits) {
+    out << "  " << std::left << std::setw(18) << name << std::right
+        << std::setw(9) << sampled.min << " .. " << std::setw(9) << sampled.max;
+    if (any_hits) {
+        out << "   hits in " << std::setw(9) << hits.min << " .. " << std::setw(9) << hits.max;
+    }
+    out << "\n";
+}
+
+void writeSweepSummary(const LaunchSweepResult& result, const LaunchSweepConfig& config, std::ostream& out) {
+    const double total = result.launches > 0 ? static_cast<double>(result.launches) : 1.0;
+    const bool any_hits = result.hits > 0;
+
+    out << std::fixed << std::setprecision(6);
+    out << "Launch sweep: " << result.launches << " launches, dt = " << config.dt << " s, seed = " << config.seed << "\n";
+    out << std::setprecision(3);
+    out << "  hits           " << std::setw(12) << result.hits << "  (" << 100.0 * result.hits / total << " %)\n";
+    out << "  out of bounds  " << std::setw(12) << result.out_of_bounds << "  (" << 100.0 * result.out_of_bounds / total << " %)\n";
+    out << "  timed out      " << std::setw(12) << result.timeouts << "  (" << 100.0 * result.timeouts / total << " %)\n";
+    out << "  mean hit time  " << std::setw(12) << result.mean_hit_time_s << " s\n";
+    out << "  mean steps     " << std::setw(12) << result.mean_steps << "\n";
+
+    out << "Parameters (sampled range, range that scored):\n";
+    writeRangeLine(out, "speed (m/s)", config.speed_m_s, result.hit_speed_m_s, any_hits);
+    writeRangeLine(out, "angle (deg)", config.angle_deg, result.hit_angle_deg, any_hits);
+    writeRangeLine(out, "gravity (m/s^2)", config.gravity, result.hit_gravity, any_hits);
+    writeRangeLine(out, "launch height (m)", config.launch_height_m, result.hit_launch_height_m, any_hits);
+    writeRangeLine(out, "cart distance (m)", config.cart_distance_m, result.hit_cart_distance_m, any_hits);
+
+    out << std::setprecision(2);
+    out << "Throughput: " << result.launches_per_second / 1e6 << " M launches/s (" << result.simd_path
+        << " lanes, " << result.seconds << " s)\n";
+}
+
+void writeSweepGridCsv(const LaunchSweepResult& result, const LaunchSweepConfig& config, std::ostream& out) {
+    // Bin centers
+    auto center = [](const SweepRange& range, int bin, int bins) {
+        return range.min + (range.max - range.min) * (bin + 0.5f) / bins;
+    };
+
+    out << "speed_m_s,angle_deg,launches,hits,hit_rate\n";
+    out << std::fixed;
+    for (int a = 0; a < result.angle_bins; ++a) {
+        for (int s = 0; s < result.speed_bins; ++s) {
+            std::size_t bin = static_cast<std::size_t>(a) * result.speed_bins + s;
+            std::uint32_t launches = result.bin_launches[bin];
+            std::uint32_t hits = result.bin_hits[bin];
+            out << std::setprecision(4) << center(config.speed_m_s, s, result.speed_bins) << ','
+                << center(config.angle_deg, a, result.angle_bins) << ','
+                << launches << ',' << hits << ','
+                << (launches > 0 ? static_cast<double>(hits) / launches : 0.0) << "\n";
+        }
+    }
+}
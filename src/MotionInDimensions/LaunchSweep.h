@@ -0,0 +1,116 @@
+#pragma once
+#ifndef LAUNCH_SWEEP_H
+#define LAUNCH_SWEEP_H
+
+#include "ProjectileScenario.h"
+#include "TaskScheduler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Batch Launch Sweep
+//
+// Evaluates millions of projectile launches without a window. Each launch is stepped
+// with exactly the arithmetic of Ball::update (semi-implicit Euler at a fixed dt) and
+// stopped by the same swept checks Ball::advance makes after every step (checkBallStep):
+//     the step's segment touches the basket (kBasketRadius)  -> hit
+//     the step's segment leaves the window                   -> miss
+// (a hit wins if it happens earlier in the step than the exit).
+//
+// Launches are spread over the TaskScheduler's threads, and each thread steps 4, 8 or
+// 16 launches at once in SIMD lanes (SSE2 / AVX2 / AVX-512, picked at runtime). When a
+// lane's launch finishes, the next launch is loaded into that lane right away.
+//-------------------------------------------------------------------------------------------------
+
+// Range a launch parameter is sampled from, [min, max) (min == max keeps it fixed)
+struct SweepRange {
+    float min;
+    float max;
+};
+
+struct LaunchSweepConfig {
+    SweepRange speed_m_s = { 5.f, 20.f };
+    SweepRange angle_deg = { 0.f, 90.f };
+    SweepRange gravity = { kDefaultGravity, kDefaultGravity };
+    SweepRange launch_height_m = { 0.f, kMaxLaunchHeight };
+    SweepRange cart_distance_m = { (kCartInitialX - kCharacterInitialX) / kScale, (kCartInitialX - kCharacterInitialX) / kScale };
+
+    std::size_t launches = 1000000;   // Monte Carlo samples
+    std::uint64_t seed = 1;           // same seed -> same launches, whatever the thread count
+    float dt = kPhysicsDt;            // physics step (s)
+    int max_steps = 100000;           // launches still flying after this many steps count as timeouts
+
+    // Resolution of the hit/miss map over (speed, angle)
+    int speed_bins = 64;
+    int angle_bins = 64;
+};
+
+enum class LaunchOutcome {
+    Scored,
+    OutOfBounds,
+    TimedOut
+};
+
+struct LaunchSweepResult {
+    std::size_t launches = 0;
+    std::size_t hits = 0;
+    std::size_t out_of_bounds = 0;
+    std::size_t timeouts = 0;
+
+    double mean_hit_time_s = 0.0;     // average flight time of the scoring launches, up to the swept hit point
+    double mean_steps = 0.0;          // average physics steps per launch
+
+    // Smallest range of each parameter that contains every scoring launch
+    SweepRange hit_speed_m_s = { 0.f, 0.f };
+    SweepRange hit_angle_deg = { 0.f, 0.f };
+    SweepRange hit_gravity = { 0.f, 0.f };
+    SweepRange hit_launch_height_m = { 0.f, 0.f };
+    SweepRange hit_cart_distance_m = { 0.f, 0.f };
+
+    // Hit/miss map: bin (speed_bin, angle_bin) is at [angle_bin * speed_bins + speed_bin]
+    int speed_bins = 0;
+    int angle_bins = 0;
+    std::vector<std::uint32_t> bin_launches;
+    std::vector<std::uint32_t> bin_hits;
+
+    const char* simd_path = "";       // which lane width was used
+    double seconds = 0.0;
+    double launches_per_second = 0.0;
+
+    // Heap allocations made while the chunks ran (always 0 without allocation tracking,
+    // see AllocationTracker.h); the setup before and the merge after don't count
+    std::uint64_t allocations = 0;
+};
+
+// The launch with this index in the sweep (deterministic: depends only on seed and index)
+ProjectileLaunch sampleLaunch(const LaunchSweepConfig& config, std::size_t index);
+
+// Scalar reference: steps one launch until it scores, leaves the window or times out
+LaunchOutcome simulateLaunch(const ProjectileLaunch& launch, float dt, int max_steps, int* steps_taken = nullptr);
+
+// Every state of one launch, one array per field: the launch state at t = 0, then one sample per step
+struct LaunchTrace {
+    std::vector<float> t_s;
+    std::vector<float> x_m, y_m;
+    std::vector<float> vx_m_s, vy_m_s;
+
+    std::size_t size() const { return t_s.size(); }
+    void clear();
+};
+
+// Same as simulateLaunch, but keeps every state in "trace"
+LaunchOutcome traceLaunch(const ProjectileLaunch& launch, float dt, int max_steps, LaunchTrace& trace);
+
+// Runs the whole sweep on the scheduler's threads
+LaunchSweepResult runLaunchSweep(const LaunchSweepConfig& config, TaskScheduler& scheduler);
+
+// Human-readable summary
+void writeSweepSummary(const LaunchSweepResult& result, const LaunchSweepConfig& config, std::ostream& out);
+
+// Hit/miss map as CSV: speed_m_s, angle_deg, launches, hits, hit_rate
+void writeSweepGridCsv(const LaunchSweepResult& result, const LaunchSweepConfig& config, std::ostream& out);
+
+#endif
@@ -1,124 +1,135 @@
 #include "ProjectileMotion.h"
-#include "Ball.h"
+#include "ProjectileScenario.h"
+#include "SessionRecording.h"
+#include "Profiler.h"
+#include "SimulationRegistry.h"
+#include "TraceCapture.h"
 
 #include <SFML/Graphics.hpp>
+#include <charconv>
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <utility>
 #include <string>
-#include <sstream>
-#include <iomanip>
 
 //-------------------------------------------------------------------------------------------------
-// Enumerations and Constants
+// Constants
 //-------------------------------------------------------------------------------------------------
-enum ActiveField {
-    kNoActiveField,
-    kSpeedField,
-    kGravityField
-    // Note: Angle field is read-only
-};
-
-// Initial states and defaults
-static const float kWindowWidth = 1920.f;
-static const float kWindowHeight = 1080.f;
-static const float kFrameRateLimit = 60.f;
-
-static const float kGroundLineY = 800.f;         // Y coordinate for "ground"
-static const float kCharacterInitialX = 118.f;   // Initial 'x' position of character sprite
-static const float kCartInitialX = 1550.f;       // Initial 'x' position of cart sprite
-
-static const float kDefaultSpeed = 11.5f;        // Default launch speed (m/s)
-static const float kDefaultGravity = 9.8f;       // Default gravity (m/s^2)
-static const float kDefaultAngleDeg = 45.0f;     // Default launch angle (degrees)
-
-static const float kScale = 100.f;               // Pixel-to-meter scale factor
+// Initial states and defaults (shared scene geometry lives in ProjectileScenario.h)
+static const int kMaxSubstepsPerFrame = 16;      // Cap so a slow frame can't snowball ("spiral of death")
+static const float kMaxFrameTime = 0.25f;        // Longest real frame time (s) fed to the accumulator
 
 static const float kTextFieldWidth = 150.f;
 static const float kTextFieldHeight = 40.f;
+static const float kPlatformWidth = 160.f;
+
+// Everything load() needs; the menu prefetches it while the entry is highlighted.
+// The four images are packed into one texture (cached under cache/), so the sprite
+// batch can draw them without switching textures.
+static const char kFontFile[] = "retrogaming.ttf";
+static const AtlasManifest kAtlasManifest = {
+    "cache/projectile_atlas",
+    {
+        { "background", "src/MotionInDimensions/imgs/background.jpg" },
+        { "character", "src/MotionInDimensions/imgs/character.png" },
+        { "ball", "src/MotionInDimensions/imgs/ball.png" },
+        { "cart", "src/MotionInDimensions/imgs/cart.png" }
+    }
+};
 
 //-------------------------------------------------------------------------------------------------
 // Local Helper Lambda for Parsing
 //-------------------------------------------------------------------------------------------------
 static auto ParseFloat = [](const std::string& str, float default_val) -> float {
-    try {
-        return std::stof(str); // Checks if string can be float
-    }
-    catch (...) {
+    // from_chars instead of std::stof: a bad field (e.g. empty or ".") is no exception
+    // and no allocation, just the backup value
+    float value;
+    std::from_chars_result result = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (result.ec != std::errc()) {
         return default_val; // Refer to a backup value
     }
+    return value;
     };
 
 //-------------------------------------------------------------------------------------------------
-// Function: runProjectileMotionSimulation
+// Registration
+//-------------------------------------------------------------------------------------------------
+const AssetManifest& getProjectileAssets() {
+    static const AssetManifest assets = { { kFontFile }, { kAtlasManifest } };
+    return assets;
+}
+
+void registerProjectileMotion(SimulationRegistry& registry) {
+    SimulationInfo info;
+    info.topic = "Motion in One and Two Dimensions";
+    info.name = "Projectile Motion";
+    info.assets = getProjectileAssets();
+    info.create = [](SceneStack& stack, SessionRecorder* recorder, std::string& error) -> std::unique_ptr<Scene> {
+        auto scene = std::make_unique<ProjectileMotionScene>(stack, recorder);
+        if (!scene->load(error)) {
+            return nullptr;
+        }
+        return scene;
+    };
+    registry.add(std::move(info));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Class: ProjectileMotionScene
+//-------------------------------------------------------------------------------------------------
+ProjectileMotionScene::ProjectileMotionScene(SceneStack& stack, SessionRecorder* recorder)
+    : stack(stack), window(stack.getWindow()), recorder(recorder),
+      volleyball(0.f, 0.f, 0.f, 0.f), volleyball_sprite(kScale), arrow_angle(kDefaultAngleDeg),
+      character_arrow_offset(30.f, -175.f)
+{
+    zone_update = stack.getProfiler().addZone("Update");
+    zone_physics = stack.getProfiler().addZone("Physics");
+}
+
+//-------------------------------------------------------------------------------------------------
+// Function: load
 //
 // Description:
-//     Main function to run the projectile motion simulation. Handles loading assets, setting up
-//     the window, initializing UI elements, processing events, running the simulation, and rendering.
-//
-// Parameters:
-//     None
+//     Gets the font and textures and sets up the sprites and UI elements.
 //
 // Returns:
-//     void
+//     false (with "error" set) if a resource could not be loaded
 //-------------------------------------------------------------------------------------------------
-void runProjectileMotionSimulation() {
-    //-----------------------------------------------------------------------------
-    // Window & Rendering Setup
-    //-----------------------------------------------------------------------------
-    sf::RenderWindow window(sf::VideoMode(static_cast<unsigned int>(kWindowWidth),
-        static_cast<unsigned int>(kWindowHeight)),
-        "Projectile Motion Simulator",
-        sf::Style::Close);
-    window.setFramerateLimit(static_cast<unsigned int>(kFrameRateLimit));
+bool ProjectileMotionScene::load(std::string& error) {
+    const std::int64_t load_start_ns = getTraceTime();
 
     //-----------------------------------------------------------------------------
-    // Load Font
-    //-----------------------------------------------------------------------------
-    sf::Font font;
-    if (!font.loadFromFile("retrogaming.ttf")) {
-        std::cerr << "Error: Could not load font 'retrogaming.ttf'.\n";
-        return;
-    }
-
-    //-----------------------------------------------------------------------------
-    // Load Textures & Sprites
+    // Load Font & Textures
+    //
+    // Fonts and the atlas come from the shared caches: the menu already loaded the
+    // font and normally prefetched the atlas, and entering the simulation again finds
+    // both still loaded.
     //-----------------------------------------------------------------------------
-    sf::Texture background_texture;
-    if (!background_texture.loadFromFile("src/MotionInDimensions/imgs/background.jpg")) {
-        std::cerr << "Error: Could not load 'background.jpg'.\n";
-        return;
-    }
-
-    sf::Texture character_texture;
-    if (!character_texture.loadFromFile("src/MotionInDimensions/imgs/character.png")) {
-        std::cerr << "Error: Could not load 'character.png'.\n";
-        return;
+    font = ResourceCache<sf::Font>::getDefault().load(kFontFile, error);
+    if (!font) {
+        return false;
     }
 
-    sf::Texture ball_texture;
-    if (!ball_texture.loadFromFile("src/MotionInDimensions/imgs/ball.png")) {
-        std::cerr << "Error: Could not load 'ball.png'.\n";
-        return;
+    atlas = loadAtlas(kAtlasManifest, error);
+    if (!atlas) {
+        return false;
     }
+    recordTraceEvent("Load assets", load_start_ns, getTraceTime());
 
-    sf::Texture cart_texture;
-    if (!cart_texture.loadFromFile("src/MotionInDimensions/imgs/cart.png")) {
-        std::cerr << "Error: Could not load 'cart.png'.\n";
-        return;
-    }
+    window_size = window.getSize();
 
     // Create background sprite and scale to window size
-    sf::Sprite sprite_background(background_texture);
+    sprite_background = atlas->makeSprite("background");
     {
-        sf::Vector2u texture_size = background_texture.getSize();
-        sf::Vector2u window_size = window.getSize();
-        float scale_x = static_cast<float>(window_size.x) / texture_size.x;
-        float scale_y = static_cast<float>(window_size.y) / texture_size.y;
+        sf::FloatRect texture_size = sprite_background.getLocalBounds();
+        float scale_x = static_cast<float>(window_size.x) / texture_size.width;
+        float scale_y = static_cast<float>(window_size.y) / texture_size.height;
         sprite_background.setScale(scale_x, scale_y);
     }
 
     // Set up character sprite
-    sf::Sprite sprite_character(character_texture);
+    sprite_character = atlas->makeSprite("character");
     {
         sf::FloatRect char_bounds = sprite_character.getLocalBounds();
         sprite_character.setOrigin(char_bounds.width / 2.f, char_bounds.height / 2.f);
@@ -126,7 +137,7 @@ void runProjectileMotionSimulation() {
     }
 
     // Set up cart (target) sprite
-    sf::Sprite sprite_cart(cart_texture);
+    sprite_cart = atlas->makeSprite("cart");
     {
         sf::FloatRect cart_bounds = sprite_cart.getLocalBounds();
         sprite_cart.setOrigin(cart_bounds.width / 2.f, cart_bounds.height / 2.f);
@@ -136,11 +147,11 @@ void runProjectileMotionSimulation() {
     //-----------------------------------------------------------------------------
     // UI Elements: Buttons
     //-----------------------------------------------------------------------------
-    sf::RectangleShape simulate_button(sf::Vector2f(200.f, 60.f));
+    simulate_button.setSize(sf::Vector2f(200.f, 60.f));
     simulate_button.setFillColor(sf::Color::Blue);
     simulate_button.setPosition(860.f, 900.f);
 
-    sf::Text simulate_text("Simulate", font, 30);
+    simulate_text = sf::Text("Simulate", *font, 30);
     {
         sf::FloatRect btn_bounds = simulate_text.getLocalBounds();
         simulate_text.setOrigin(btn_bounds.width / 2.f, btn_bounds.height / 2.f);
@@ -148,11 +159,11 @@ void runProjectileMotionSimulation() {
             simulate_button.getPosition().y + simulate_button.getSize().y / 2.f);
     }
 
-    sf::RectangleShape reset_button(sf::Vector2f(200.f, 60.f));
+    reset_button.setSize(sf::Vector2f(200.f, 60.f));
     reset_button.setFillColor(sf::Color::Red);
     reset_button.setPosition(1080.f, 900.f);
 
-    sf::Text reset_text("Reset", font, 30);
+    reset_text = sf::Text("Reset", *font, 30);
     {
         sf::FloatRect rt_bounds = reset_text.getLocalBounds();
         reset_text.setOrigin(rt_bounds.width / 2.f, rt_bounds.height / 2.f);
@@ -161,92 +172,75 @@ void runProjectileMotionSimulation() {
     }
 
     //-----------------------------------------------------------------------------
-    // Simulation State Variables
-    //-----------------------------------------------------------------------------
-    bool simulation_running = false;
-    bool goal_scored = false;
-    bool out_of_bounds = false;
-    bool ball_initialized = false;
-
-    Ball volleyball(0, 0, 0, 0); // Will be initialized properly only once simulation starts
-
-    sf::Text status_text;
-    status_text.setFont(font);
-    status_text.setCharacterSize(60);
-    status_text.setFillColor(sf::Color::Yellow);
-    status_text.setPosition(800.f, 500.f);
-
-    //-----------------------------------------------------------------------------
-    // Dragging States for Adjustment (Character, Cart, Angle)
+    // Status Text and UI Fields
     //-----------------------------------------------------------------------------
-    bool dragging_character = false;
-    bool dragging_cart = false;
-    bool dragging_arrow = false;
-    sf::Vector2f drag_offset;
+    goal_text = sf::Text("Goal!", *font, 60);
+    goal_text.setFillColor(sf::Color::Yellow);
+    goal_text.setPosition(800.f, 500.f);
 
-    //-----------------------------------------------------------------------------
-    // Parameters and UI Fields
-    //-----------------------------------------------------------------------------
-    std::string speed_str = "11.5";
-    std::string gravity_str = "9.8";
-    float arrow_angle = kDefaultAngleDeg; // degrees, with convention: 0=Up, 90=Right
-    std::string angle_str = "45.0";
+    no_goal_text = sf::Text("No Goal!", *font, 60);
+    no_goal_text.setFillColor(sf::Color::Yellow);
+    no_goal_text.setPosition(800.f, 500.f);
 
-    sf::Vector2u window_size = window.getSize();
+    // Lay out their glyphs now, so the frame a throw ends on doesn't allocate
+    goal_text.getLocalBounds();
+    no_goal_text.getLocalBounds();
 
     // Speed input field
-    sf::RectangleShape speed_field_rect(sf::Vector2f(kTextFieldWidth, kTextFieldHeight));
+    speed_field_rect.setSize(sf::Vector2f(kTextFieldWidth, kTextFieldHeight));
     speed_field_rect.setFillColor(sf::Color::White);
     speed_field_rect.setPosition(window_size.x - 200.f, 50.f);
 
     // Angle display field (read-only)
-    sf::RectangleShape angle_field_rect(sf::Vector2f(kTextFieldWidth, kTextFieldHeight));
+    angle_field_rect.setSize(sf::Vector2f(kTextFieldWidth, kTextFieldHeight));
     angle_field_rect.setFillColor(sf::Color::White);
     angle_field_rect.setPosition(window_size.x - 200.f, 120.f);
 
     // Gravity input field
-    sf::RectangleShape gravity_field_rect(sf::Vector2f(kTextFieldWidth, kTextFieldHeight));
+    gravity_field_rect.setSize(sf::Vector2f(kTextFieldWidth, kTextFieldHeight));
     gravity_field_rect.setFillColor(sf::Color::White);
     gravity_field_rect.setPosition(window_size.x - 200.f, 190.f);
 
     // Field Labels
-    sf::Text speed_label("Speed (m/s):", font, 20);
+    speed_label = sf::Text("Speed (m/s):", *font, 20);
     speed_label.setFillColor(sf::Color::Black);
     speed_label.setPosition(window_size.x - 370.f, 50.f);
 
-    sf::Text angle_label("Angle (deg):", font, 20);
+    angle_label = sf::Text("Angle (deg):", *font, 20);
     angle_label.setFillColor(sf::Color::Black);
     angle_label.setPosition(window_size.x - 370.f, 120.f);
 
-    sf::Text gravity_label("Gravity (m/s^2):", font, 20);
+    gravity_label = sf::Text("Gravity (m/s^2):", *font, 20);
     gravity_label.setFillColor(sf::Color::Black);
     gravity_label.setPosition(window_size.x - 410.f, 190.f);
 
     // Field Texts
-    sf::Text speed_text(speed_str, font, 20);
+    speed_text = sf::Text(speed_str, *font, 20);
     speed_text.setFillColor(sf::Color::Black);
     speed_text.setPosition(speed_field_rect.getPosition().x + 10.f, speed_field_rect.getPosition().y + 5.f);
 
-    sf::Text angle_text(angle_str, font, 20); // Angle is read-only
-    angle_text.setFillColor(sf::Color::Black);
-    angle_text.setPosition(angle_field_rect.getPosition().x + 10.f, angle_field_rect.getPosition().y + 5.f);
+    angle_text.getText() = sf::Text("", *font, 20); // Angle is read-only
+    angle_text.getText().setFillColor(sf::Color::Black);
+    angle_text.getText().setPosition(angle_field_rect.getPosition().x + 10.f, angle_field_rect.getPosition().y + 5.f);
+    angle_text.setNumber("", arrow_angle, 1);
 
-    sf::Text gravity_text(gravity_str, font, 20);
+    gravity_text = sf::Text(gravity_str, *font, 20);
     gravity_text.setFillColor(sf::Color::Black);
     gravity_text.setPosition(gravity_field_rect.getPosition().x + 10.f, gravity_field_rect.getPosition().y + 5.f);
 
-    ActiveField active_field = kNoActiveField;
+    cursor_text = sf::Text("|", *font, 20);
+    cursor_text.setFillColor(sf::Color::Black);
 
     //-----------------------------------------------------------------------------
     // Distance and Height Display
     //-----------------------------------------------------------------------------
-    sf::Text distance_text("", font, 30);
-    distance_text.setFillColor(sf::Color::Red);
-    distance_text.setPosition(100.f, 100.f);
+    distance_text.getText() = sf::Text("", *font, 30);
+    distance_text.getText().setFillColor(sf::Color::Red);
+    distance_text.getText().setPosition(100.f, 100.f);
 
-    sf::Text height_text("", font, 30);
-    height_text.setFillColor(sf::Color::Red);
-    height_text.setPosition(100.f, 150.f);
+    height_text.getText() = sf::Text("", *font, 30);
+    height_text.getText().setFillColor(sf::Color::Red);
+    height_text.getText().setPosition(100.f, 150.f);
 
     //-----------------------------------------------------------------------------
     // Arrow Setup (used to visualize angle)
@@ -257,8 +251,6 @@ void runProjectileMotionSimulation() {
     //
     // The arrow is positioned relative to the character position.
     //-----------------------------------------------------------------------------
-    sf::Vector2f character_arrow_offset(30.f, -175.f);
-    sf::ConvexShape arrow_shape;
     arrow_shape.setPointCount(7);
     // Shape definition of arrow:
     // A simple arrow with a shaft and a pointed tip.
@@ -272,356 +264,386 @@ void runProjectileMotionSimulation() {
     arrow_shape.setFillColor(sf::Color::Red);
 
     // Platform Under Character 
-    sf::RectangleShape platform_rect;
     platform_rect.setFillColor(sf::Color(139, 69, 19));
-    float platform_width = 160.f;
 
-    //-----------------------------------------------------------------------------
-    // Lambda to reset simulation states
-    //-----------------------------------------------------------------------------
-    auto resetSimulation = [&]() {
-        simulation_running = false;
-        goal_scored = false;
-        out_of_bounds = false;
-        ball_initialized = false;
+    return true;
+}
 
-        // Reset positions
-        sprite_character.setPosition(kCharacterInitialX, kGroundLineY);
-        sprite_cart.setPosition(kCartInitialX, kGroundLineY);
+//-------------------------------------------------------------------------------------------------
+// Function: resetSimulation
+//-------------------------------------------------------------------------------------------------
+void ProjectileMotionScene::resetSimulation() {
+    simulation_running = false;
+    goal_scored = false;
+    out_of_bounds = false;
+    ball_initialized = false;
+
+    // Reset positions
+    sprite_character.setPosition(kCharacterInitialX, kGroundLineY);
+    sprite_cart.setPosition(kCartInitialX, kGroundLineY);
+
+    // Reset fields
+    speed_str = "11.5";
+    gravity_str = "9.8";
+    speed_text.setString(speed_str);
+    gravity_text.setString(gravity_str);
+
+    // Reset angle
+    arrow_angle = kDefaultAngleDeg;
+    angle_text.setNumber("", arrow_angle, 1);
+
+    active_field = kNoActiveField;
+}
 
-        // Reset fields
-        speed_str = "11.5";
-        gravity_str = "9.8";
-        speed_text.setString(speed_str);
-        gravity_text.setString(gravity_str);
+//-------------------------------------------------------------------------------------------------
+// Event Handling
+//-------------------------------------------------------------------------------------------------
+void ProjectileMotionScene::handleEvent(const sf::Event& event) {
+    // Anything but a plain mouse move can change the picture; moves only do while dragging
+    if (event.type != sf::Event::MouseMoved || dragging_character || dragging_cart || dragging_arrow) {
+        stack.invalidate();
+    }
 
-        // Reset angle
-        arrow_angle = kDefaultAngleDeg;
-        angle_str = "45.0";
-        angle_text.setString(angle_str);
+    // Back to the menu (closing the window and F3 are handled by the scene stack)
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+        stack.pop();
+    }
+    // Handle window resizing 
+    else if (event.type == sf::Event::Resized) {
+        sf::Vector2u new_size(event.size.width, event.size.height);
+        sf::FloatRect tex_size = sprite_background.getLocalBounds();
+        float scale_x = static_cast<float>(new_size.x) / tex_size.width;
+        float scale_y = static_cast<float>(new_size.y) / tex_size.height;
+        sprite_background.setScale(scale_x, scale_y);
+    }
+    // Mouse Pressed
+    else if (event.type == sf::Event::MouseButtonPressed) {
+        sf::Vector2f mouse_pos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
+        if (!simulation_running && !ball_initialized) {
+            // Start simulation if "Simulate" button is clicked
+            if (simulate_button.getGlobalBounds().contains(mouse_pos)) {
+                float initial_speed = ParseFloat(speed_str, kDefaultSpeed);
+                float gravity_val = ParseFloat(gravity_str, kDefaultGravity);
+
+                // Convert arrow_angle to projectile angle:
+                // projectile angle: 0=Right, 90=Up
+                // arrow_angle: 0=Up, 90=Right
+                // Relationship: projectile_angle = 90 - arrow_angle
+                float initial_angle = 90.f - arrow_angle;
+
+                simulation_running = true;
+
+                float ball_start_x_m = sprite_character.getPosition().x / kScale;
+                float ball_start_y_m = (sprite_character.getPosition().y - kBallReleaseOffsetY) / kScale;
+                volleyball = Ball(ball_start_x_m, ball_start_y_m, initial_speed, initial_angle, gravity_val);
+                throw_steps = 0;
+
+                if (recorder) {
+                    RecordedLaunch launch = { stack.getFrameIndex(), ball_start_x_m, ball_start_y_m,
+                        initial_speed, initial_angle, gravity_val,
+                        sprite_cart.getPosition().x / kScale, sprite_cart.getPosition().y / kScale, kBasketRadius,
+                        static_cast<float>(window_size.x) / kScale, static_cast<float>(window_size.y) / kScale };
+                    recorder->recordLaunch(launch);
+                }
 
-        active_field = kNoActiveField;
-        };
+                // Setup ball sprite
+                sf::Sprite sprite_ball = atlas->makeSprite("ball");
+                sprite_ball.setScale(0.25f, 0.25f);
+                sf::FloatRect ball_bounds = sprite_ball.getLocalBounds();
+                sprite_ball.setOrigin(ball_bounds.width / 2.f, ball_bounds.height / 2.f);
+                volleyball_sprite.setSprite(sprite_ball);
 
-    //-----------------------------------------------------------------------------
-    // Main Loop
-    //-----------------------------------------------------------------------------
-    while (window.isOpen()) {
-        float dt = 1.f / kFrameRateLimit;
-
-        //-------------------------------------------------------------------------
-        // Event Handling
-        //-------------------------------------------------------------------------
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            // Handle window close
-            if (event.type == sf::Event::Closed) {
-                window.close();
+                ball_initialized = true;
+                accumulator = 0.f;
             }
-            // Handle window resizing 
-            else if (event.type == sf::Event::Resized) {
-                sf::Vector2u new_size(event.size.width, event.size.height);
-                sf::Vector2u tex_size = background_texture.getSize();
-                float scale_x = static_cast<float>(new_size.x) / tex_size.x;
-                float scale_y = static_cast<float>(new_size.y) / tex_size.y;
-                sprite_background.setScale(scale_x, scale_y);
-            }
-            // Mouse Pressed
-            else if (event.type == sf::Event::MouseButtonPressed) {
-                sf::Vector2f mouse_pos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
-                if (!simulation_running && !ball_initialized) {
-                    // Start simulation if "Simulate" button is clicked
-                    if (simulate_button.getGlobalBounds().contains(mouse_pos)) {
-                        float initial_speed = ParseFloat(speed_str, kDefaultSpeed);
-                        float gravity_val = ParseFloat(gravity_str, kDefaultGravity);
-
-                        // Convert arrow_angle to projectile angle:
-                        // projectile angle: 0=Right, 90=Up
-                        // arrow_angle: 0=Up, 90=Right
-                        // Relationship: projectile_angle = 90 - arrow_angle
-                        float initial_angle = 90.f - arrow_angle;
-
-                        simulation_running = true;
-
-                        float ball_start_x_m = sprite_character.getPosition().x / kScale;
-                        float ball_start_y_m = (sprite_character.getPosition().y - 251.f) / kScale;
-                        volleyball = Ball(ball_start_x_m, ball_start_y_m, initial_speed, initial_angle, gravity_val, kScale);
-
-                        // Setup ball sprite
-                        sf::Sprite sprite_ball(ball_texture);
-                        sprite_ball.setScale(0.25f, 0.25f);
-                        sf::FloatRect ball_bounds = sprite_ball.getLocalBounds();
-                        sprite_ball.setOrigin(ball_bounds.width / 2.f, ball_bounds.height / 2.f);
-                        volleyball.setSprite(sprite_ball);
-
-                        ball_initialized = true;
+            else {
+                // Check if user clicked on character (vertical dragging)
+                if (sprite_character.getGlobalBounds().contains(mouse_pos)) {
+                    dragging_character = true;
+                    drag_offset = sprite_character.getPosition() - mouse_pos;
+                }
+                // Check if user clicked on cart (horizontal dragging)
+                else if (sprite_cart.getGlobalBounds().contains(mouse_pos)) {
+                    dragging_cart = true;
+                    drag_offset = sprite_cart.getPosition() - mouse_pos;
+                }
+                // Check speed field activation
+                else if (speed_field_rect.getGlobalBounds().contains(mouse_pos)) {
+                    active_field = kSpeedField;
+                }
+                // Check gravity field activation
+                else if (gravity_field_rect.getGlobalBounds().contains(mouse_pos)) {
+                    active_field = kGravityField;
+                }
+                else {
+                    // Check if user clicked on arrow (angle adjustment)
+                    sf::FloatRect arrow_bounds = arrow_shape.getGlobalBounds();
+                    if (arrow_bounds.contains(mouse_pos)) {
+                        dragging_arrow = true;
                     }
                     else {
-                        // Check if user clicked on character (vertical dragging)
-                        if (sprite_character.getGlobalBounds().contains(mouse_pos)) {
-                            dragging_character = true;
-                            drag_offset = sprite_character.getPosition() - mouse_pos;
-                        }
-                        // Check if user clicked on cart (horizontal dragging)
-                        else if (sprite_cart.getGlobalBounds().contains(mouse_pos)) {
-                            dragging_cart = true;
-                            drag_offset = sprite_cart.getPosition() - mouse_pos;
-                        }
-                        // Check speed field activation
-                        else if (speed_field_rect.getGlobalBounds().contains(mouse_pos)) {
-                            active_field = kSpeedField;
-                        }
-                        // Check gravity field activation
-                        else if (gravity_field_rect.getGlobalBounds().contains(mouse_pos)) {
-                            active_field = kGravityField;
-                        }
-                        else {
-                            // Check if user clicked on arrow (angle adjustment)
-                            sf::FloatRect arrow_bounds = arrow_shape.getGlobalBounds();
-                            if (arrow_bounds.contains(mouse_pos)) {
-                                dragging_arrow = true;
-                            }
-                            else {
-                                active_field = kNoActiveField;
-                            }
-                        }
-                    }
-                }
-                else if (!simulation_running && ball_initialized) {
-                    // If simulation ended, allow "Reset"
-                    if (reset_button.getGlobalBounds().contains(mouse_pos)) {
-                        resetSimulation();
+                        active_field = kNoActiveField;
                     }
                 }
             }
-            // Mouse Released
-            else if (event.type == sf::Event::MouseButtonReleased) {
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    dragging_character = false;
-                    dragging_cart = false;
-                    dragging_arrow = false;
-                }
+        }
+        else if (!simulation_running && ball_initialized) {
+            // If simulation ended, allow "Reset"
+            if (reset_button.getGlobalBounds().contains(mouse_pos)) {
+                resetSimulation();
             }
-            // Mouse Moved (dragging to adjust positions/angle)
-            else if (event.type == sf::Event::MouseMoved && !simulation_running && !ball_initialized) {
-                sf::Vector2f mouse_pos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
-
-                if (dragging_character) {
-                    // Move character vertically only
-                    float new_y = mouse_pos.y + drag_offset.y;
-                    float max_y = kGroundLineY - (5.35f * kScale); // Limit height dragging so char stays in window 
-                    if (new_y < max_y) new_y = max_y;
-                    if (new_y > kGroundLineY) new_y = kGroundLineY; // Prevent height dragging down
-                    sprite_character.setPosition(sprite_character.getPosition().x, new_y);
-                }
-                else if (dragging_cart) {
-                    // Move cart horizontally only
-                    float new_x = mouse_pos.x + drag_offset.x;
-                    sprite_cart.setPosition(new_x, sprite_cart.getPosition().y);
-                }
-                else if (dragging_arrow) {
-                    // Recompute angle based on mouse position relative to arrow pivot
-                    sf::Vector2f arrow_pivot = sprite_character.getPosition() + character_arrow_offset;
-                    sf::Vector2f diff = mouse_pos - arrow_pivot;
-                    float angle_rad = std::atan2(diff.y, diff.x);
-                    float angle_deg = angle_rad * 180.f / 3.14159f + 90.f;
-
-                    arrow_angle = angle_deg;
-
-                    // Update angle text display
-                    std::stringstream angle_stream;
-                    angle_stream << std::fixed << std::setprecision(1) << arrow_angle;
-                    angle_str = angle_stream.str();
-                    angle_text.setString(angle_str);
-                }
+        }
+    }
+    // Mouse Released
+    else if (event.type == sf::Event::MouseButtonReleased) {
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            dragging_character = false;
+            dragging_cart = false;
+            dragging_arrow = false;
+        }
+    }
+    // Mouse Moved (dragging to adjust positions/angle)
+    else if (event.type == sf::Event::MouseMoved && !simulation_running && !ball_initialized) {
+        sf::Vector2f mouse_pos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
+
+        if (dragging_character) {
+            // Move character vertically only
+            float new_y = mouse_pos.y + drag_offset.y;
+            float max_y = kGroundLineY - (kMaxLaunchHeight * kScale); // Limit height dragging so char stays in window 
+            if (new_y < max_y) new_y = max_y;
+            if (new_y > kGroundLineY) new_y = kGroundLineY; // Prevent height dragging down
+            sprite_character.setPosition(sprite_character.getPosition().x, new_y);
+        }
+        else if (dragging_cart) {
+            // Move cart horizontally only
+            float new_x = mouse_pos.x + drag_offset.x;
+            sprite_cart.setPosition(new_x, sprite_cart.getPosition().y);
+        }
+        else if (dragging_arrow) {
+            // Recompute angle based on mouse position relative to arrow pivot
+            sf::Vector2f arrow_pivot = sprite_character.getPosition() + character_arrow_offset;
+            sf::Vector2f diff = mouse_pos - arrow_pivot;
+            float angle_rad = std::atan2(diff.y, diff.x);
+            float angle_deg = angle_rad * 180.f / 3.14159f + 90.f;
+
+            arrow_angle = angle_deg;
+
+            // Update angle text display
+            angle_text.setNumber("", arrow_angle, 1);
+        }
+    }
+    // Text Entered (input in speed/gravity fields)
+    else if (event.type == sf::Event::TextEntered && !simulation_running && !ball_initialized) {
+        if (active_field != kNoActiveField) {
+            uint32_t unicode = event.text.unicode;
+            std::string* target = nullptr;
+            sf::Text* target_text = nullptr;
+
+            if (active_field == kSpeedField) {
+                target = &speed_str;
+                target_text = &speed_text;
+            }
+            else if (active_field == kGravityField) {
+                target = &gravity_str;
+                target_text = &gravity_text;
             }
-            // Text Entered (input in speed/gravity fields)
-            else if (event.type == sf::Event::TextEntered && !simulation_running && !ball_initialized) {
-                if (active_field != kNoActiveField) {
-                    uint32_t unicode = event.text.unicode;
-                    std::string* target = nullptr;
-                    sf::Text* target_text = nullptr;
-
-                    if (active_field == kSpeedField) {
-                        target = &speed_str;
-                        target_text = &speed_text;
+
+            if (target && target_text) {
+                if (unicode == '\r') {
+                    // Enter pressed - stop editing
+                    active_field = kNoActiveField;
+                }
+                else if (unicode == '\b') {
+                    // Backspace - remove last character if exists
+                    if (!target->empty()) {
+                        target->pop_back();
+                        target_text->setString(*target);
                     }
-                    else if (active_field == kGravityField) {
-                        target = &gravity_str;
-                        target_text = &gravity_text;
+                }
+                else if ((unicode >= '0' && unicode <= '9') || unicode == '.') {
+                    // Append digit or decimal point
+                    // Allow only one decimal point
+                    if (unicode == '.' && target->find('.') != std::string::npos) {
+                        // Ignore additional decimal points
                     }
-
-                    if (target && target_text) {
-                        if (unicode == '\r') {
-                            // Enter pressed - stop editing
-                            active_field = kNoActiveField;
-                        }
-                        else if (unicode == '\b') {
-                            // Backspace - remove last character if exists
-                            if (!target->empty()) {
-                                target->pop_back();
-                                target_text->setString(*target);
-                            }
-                        }
-                        else if ((unicode >= '0' && unicode <= '9') || unicode == '.') {
-                            // Append digit or decimal point
-                            // Allow only one decimal point
-                            if (unicode == '.' && target->find('.') != std::string::npos) {
-                                // Ignore additional decimal points
-                            }
-                            else {
-                                target->push_back(static_cast<char>(unicode));
-                                target_text->setString(*target);
-                            }
-                        }
+                    else {
+                        target->push_back(static_cast<char>(unicode));
+                        target_text->setString(*target);
                     }
                 }
             }
         }
+    }
+}
 
-        //-------------------------------------------------------------------------
-        // Update Logic (runs every frame)
-        //-------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+// Update Logic (runs every frame)
+//
+// Real time is collected in an accumulator and spent in fixed kPhysicsDt steps,
+// so the ball moves at the same speed whatever the frame rate is. The leftover
+// fraction of a step is used to interpolate the ball when drawing.
+//-------------------------------------------------------------------------------------------------
+void ProjectileMotionScene::update(float frameTime) {
+    const float frame_time = frameTime < kMaxFrameTime ? frameTime : kMaxFrameTime;
 
-        // Update arrow position and rotation
-        {
-            sf::Vector2f arrow_pivot = sprite_character.getPosition() + character_arrow_offset;
-            arrow_shape.setPosition(arrow_pivot);
-            arrow_shape.setRotation(arrow_angle);
-        }
+    ScopedTimer update_timer(stack.getProfiler(), zone_update);
 
-        // Update distance and height text (difference between character and cart)
-        {
-            float dist_m = std::fabs(sprite_character.getPosition().x - sprite_cart.getPosition().x) / kScale;
-            std::stringstream dist_ss;
-            dist_ss << "Distance: " << std::fixed << std::setprecision(2) << dist_m << " m";
-            distance_text.setString(dist_ss.str());
-
-            float height_diff_m = std::fabs((sprite_character.getPosition().y - sprite_cart.getPosition().y) / kScale);
-            std::stringstream height_ss;
-            height_ss << "Height: " << std::fixed << std::setprecision(2) << height_diff_m << " m";
-            height_text.setString(height_ss.str());
-        }
+    // Update arrow position and rotation
+    {
+        sf::Vector2f arrow_pivot = sprite_character.getPosition() + character_arrow_offset;
+        arrow_shape.setPosition(arrow_pivot);
+        arrow_shape.setRotation(arrow_angle);
+    }
 
-        // Update platform rectangle under character if character is above ground
-        {
-            float char_y = sprite_character.getPosition().y;
-            float char_x = sprite_character.getPosition().x;
-            if (char_y < kGroundLineY) {
-                float platform_height = kGroundLineY - char_y;
-                platform_rect.setSize(sf::Vector2f(platform_width, platform_height));
-                platform_rect.setPosition(char_x - platform_width / 2.f, char_y + 130.f);
-            }
-            else {
-                platform_rect.setSize(sf::Vector2f(0.f, 0.f));
-            }
-        }
+    // Update distance and height text (difference between character and cart); the
+    // texts only re-lay out their glyphs when the shown digits change
+    {
+        float dist_m = std::fabs(sprite_character.getPosition().x - sprite_cart.getPosition().x) / kScale;
+        distance_text.setNumber("Distance: ", dist_m, 2, " m");
 
-        // Run physics step if simulation is active
-        if (simulation_running && ball_initialized) {
-            volleyball.update(dt);
+        float height_diff_m = std::fabs((sprite_character.getPosition().y - sprite_cart.getPosition().y) / kScale);
+        height_text.setNumber("Height: ", height_diff_m, 2, " m");
+    }
 
-            float basket_x_m = sprite_cart.getPosition().x / kScale;
-            float basket_y_m = sprite_cart.getPosition().y / kScale;
+    // Update platform rectangle under character if character is above ground
+    {
+        float char_y = sprite_character.getPosition().y;
+        float char_x = sprite_character.getPosition().x;
+        if (char_y < kGroundLineY) {
+            float platform_height = kGroundLineY - char_y;
+            platform_rect.setSize(sf::Vector2f(kPlatformWidth, platform_height));
+            platform_rect.setPosition(char_x - kPlatformWidth / 2.f, char_y + 130.f);
+        }
+        else {
+            platform_rect.setSize(sf::Vector2f(0.f, 0.f));
+        }
+    }
+    update_timer.stop();
+
+    // Run fixed physics steps for the real time that passed, if simulation is active
+    ScopedTimer physics_timer(stack.getProfiler(), zone_physics);
+    if (simulation_running && ball_initialized) {
+        accumulator += frame_time;
+
+        float basket_x_m = sprite_cart.getPosition().x / kScale;
+        float basket_y_m = sprite_cart.getPosition().y / kScale;
+
+        int substeps = 0;
+        while (simulation_running && accumulator >= kPhysicsDt && substeps < kMaxSubstepsPerFrame) {
+            // Swept basket and window checks run inside advance, so a fast ball
+            // can't pass through the basket between two steps
+            BallStepResult result = volleyball.advance(kPhysicsDt, basket_x_m, basket_y_m, kBasketRadius,
+                static_cast<float>(window_size.x) / kScale, static_cast<float>(window_size.y) / kScale);
+            accumulator -= kPhysicsDt;
+            ++substeps;
+            ++throw_steps;
+
+            if (recorder) {
+                recorder->recordStep(volleyball.getState());
+            }
 
-            // Check if goal scored (ball in basket vicinity)
-            if (volleyball.isScored(basket_x_m, basket_y_m, 1.0f)) {
+            // Check if goal scored (ball in basket vicinity) before it left the window
+            if (result == BallStepResult::Scored) {
                 simulation_running = false;
                 goal_scored = true;
             }
-
             // Check if ball goes out of visible bounds
-            if (volleyball.isOutOfBounds(static_cast<float>(window_size.x) / kScale,
-                static_cast<float>(window_size.y) / kScale)) {
+            else if (result == BallStepResult::OutOfBounds) {
                 simulation_running = false;
                 out_of_bounds = true;
             }
-        }
 
-        //-------------------------------------------------------------------------
-        // Rendering
-        //-------------------------------------------------------------------------
-        window.clear();
-        window.draw(sprite_background);
+            if (recorder && result != BallStepResult::Flying) {
+                recorder->recordEnd(result, throw_steps);
+            }
+        }
 
-        // Draw platform when needed
-        if (platform_rect.getSize().y > 0.f) {
-            window.draw(platform_rect);
+        // Too far behind: drop the backlog instead of trying to catch up next frame
+        if (substeps == kMaxSubstepsPerFrame) {
+            accumulator = 0.f;
         }
 
-        window.draw(sprite_character);
-        window.draw(sprite_cart);
-        window.draw(distance_text);
-        window.draw(height_text);
-
-        // If simulation not started yet, show UI for input and angle arrow
-        if (!ball_initialized && !simulation_running) {
-            // Draw arrow (angle indicator)
-            window.draw(arrow_shape);
-
-            // Draw input fields and labels
-            window.draw(speed_field_rect);
-            window.draw(angle_field_rect);
-            window.draw(gravity_field_rect);
-            window.draw(speed_label);
-            window.draw(angle_label);
-            window.draw(gravity_label);
-
-            // If active field is speed field, show cursor
-            if (active_field == kSpeedField) {
-                sf::FloatRect speed_bounds = speed_text.getLocalBounds();
-                sf::Text cursor("|", font, 20);
-                cursor.setFillColor(sf::Color::Black);
-                cursor.setPosition(speed_text.getPosition().x + speed_bounds.width + 2.f, speed_text.getPosition().y);
-                window.draw(speed_text);
-                window.draw(cursor);
-            }
-            else {
-                window.draw(speed_text);
-            }
+        // Once the simulation stops, show the exact final state
+        interpolation_alpha = simulation_running ? accumulator / kPhysicsDt : 1.f;
+    }
+}
 
-            // Angle is read-only
-            window.draw(angle_text);
-
-            // If active field is gravity field, show cursor
-            if (active_field == kGravityField) {
-                sf::FloatRect grav_bounds = gravity_text.getLocalBounds();
-                sf::Text cursor("|", font, 20);
-                cursor.setFillColor(sf::Color::Black);
-                cursor.setPosition(gravity_text.getPosition().x + grav_bounds.width + 2.f, gravity_text.getPosition().y);
-                window.draw(gravity_text);
-                window.draw(cursor);
-            }
-            else {
-                window.draw(gravity_text);
-            }
+//-------------------------------------------------------------------------------------------------
+// Rendering
+//-------------------------------------------------------------------------------------------------
+void ProjectileMotionScene::draw(sf::RenderWindow& window, SpriteBatch& batch) {
+    batch.draw(sprite_background);
+
+    // Draw platform when needed
+    if (platform_rect.getSize().y > 0.f) {
+        batch.draw(platform_rect);
+    }
 
-            // Draw simulate button
-            window.draw(simulate_button);
-            window.draw(simulate_text);
+    batch.draw(sprite_character);
+    batch.draw(sprite_cart);
+    batch.draw(window, distance_text.getText());
+    batch.draw(window, height_text.getText());
+
+    // If simulation not started yet, show UI for input and angle arrow
+    if (!ball_initialized && !simulation_running) {
+        // Draw arrow (angle indicator)
+        batch.draw(window, arrow_shape);
+
+        // Draw input fields and labels
+        batch.draw(speed_field_rect);
+        batch.draw(angle_field_rect);
+        batch.draw(gravity_field_rect);
+        batch.draw(window, speed_label);
+        batch.draw(window, angle_label);
+        batch.draw(window, gravity_label);
+
+        // If active field is speed field, show cursor
+        if (active_field == kSpeedField) {
+            sf::FloatRect speed_bounds = speed_text.getLocalBounds();
+            cursor_text.setPosition(speed_text.getPosition().x + speed_bounds.width + 2.f, speed_text.getPosition().y);
+            batch.draw(window, speed_text);
+            batch.draw(window, cursor_text);
+        }
+        else {
+            batch.draw(window, speed_text);
         }
 
-        // Draw the ball if initialized
-        if (ball_initialized) {
-            volleyball.draw(window);
+        // Angle is read-only
+        batch.draw(window, angle_text.getText());
+
+        // If active field is gravity field, show cursor
+        if (active_field == kGravityField) {
+            sf::FloatRect grav_bounds = gravity_text.getLocalBounds();
+            cursor_text.setPosition(gravity_text.getPosition().x + grav_bounds.width + 2.f, gravity_text.getPosition().y);
+            batch.draw(window, gravity_text);
+            batch.draw(window, cursor_text);
+        }
+        else {
+            batch.draw(window, gravity_text);
         }
 
-        // If simulation ended, show result and allow reset
-        if (!simulation_running && ball_initialized) {
-            if (goal_scored) {
-                status_text.setString("Goal!");
-            }
-            else if (out_of_bounds) {
-                status_text.setString("No Goal!");
-            }
-            window.draw(status_text);
+        // Draw simulate button
+        batch.draw(simulate_button);
+        batch.draw(window, simulate_text);
+    }
+
+    // Draw the ball if initialized
+    if (ball_initialized) {
+        volleyball_sprite.sync(volleyball.getState(), interpolation_alpha);
+        volleyball_sprite.draw(batch);
+    }
 
-            // Draw reset button
-            window.draw(reset_button);
-            window.draw(reset_text);
+    // If simulation ended, show result and allow reset
+    if (!simulation_running && ball_initialized) {
+        if (goal_scored) {
+            batch.draw(window, goal_text);
+        }
+        else if (out_of_bounds) {
+            batch.draw(window, no_goal_text);
         }
 
-        // Present the frame
-        window.display();
+        // Draw reset button
+        batch.draw(reset_button);
+        batch.draw(window, reset_text);
     }
 }
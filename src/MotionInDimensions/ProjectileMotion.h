@@ -1,7 +1,117 @@
 #pragma once
+#include "Scene.h"
+#include "Ball.h"
+#include "BallSprite.h"
+#include "HudText.h"
+#include "ResourceCache.h"
+#include "TextureAtlas.h"
+
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+
+class SessionRecorder;
+class SimulationRegistry;
+struct AssetManifest;
+
+// The projectile motion simulation, as a scene in the app's window: drag the character,
+// cart and angle arrow, type a speed and gravity, then throw. Escape goes back to the menu.
+// If "recorder" is given, the session is recorded for replay (see SessionRecording.h).
+class ProjectileMotionScene : public Scene {
+    public:
+        ProjectileMotionScene(SceneStack& stack, SessionRecorder* recorder = nullptr);
+
+        // Gets the font and textures (from the shared caches) and lays out the scene.
+        // Call it before pushing the scene.
+        bool load(std::string& error);
+
+        const char* getTitle() const override { return "Projectile Motion Simulator"; }
+        void handleEvent(const sf::Event& event) override;
+        bool isAnimating() const override { return simulation_running; } // the ball is flying
+        void update(float frameTime) override;
+        void draw(sf::RenderWindow& window, SpriteBatch& batch) override;
+
+    private:
+        enum ActiveField {
+            kNoActiveField,
+            kSpeedField,
+            kGravityField
+            // Note: Angle field is read-only
+        };
+
+        void resetSimulation();
+
+        SceneStack& stack;
+        sf::RenderWindow& window;
+        SessionRecorder* recorder;
+
+        // Shared resources
+        ResourceCache<sf::Font>::Handle font;
+        ResourceCache<TextureAtlas>::Handle atlas;
+        int zone_update;
+        int zone_physics;
+
+        // Sprites and buttons
+        sf::Sprite sprite_background;
+        sf::Sprite sprite_character;
+        sf::Sprite sprite_cart;
+        sf::RectangleShape simulate_button;
+        sf::Text simulate_text;
+        sf::RectangleShape reset_button;
+        sf::Text reset_text;
+
+        // Simulation state
+        bool simulation_running = false;
+        bool goal_scored = false;
+        bool out_of_bounds = false;
+        bool ball_initialized = false;
+
+        Ball volleyball;              // Will be initialized properly only once simulation starts
+        BallSprite volleyball_sprite; // Drawn copy of the ball, synced once per frame
+        std::uint32_t throw_steps = 0; // Physics steps of the current throw (for recording)
+        sf::Text goal_text;           // Result of a finished throw; both built once in load()
+        sf::Text no_goal_text;
+
+        // Dragging states for adjustment (character, cart, angle)
+        bool dragging_character = false;
+        bool dragging_cart = false;
+        bool dragging_arrow = false;
+        sf::Vector2f drag_offset;
+
+        // Parameters and UI fields
+        std::string speed_str = "11.5";
+        std::string gravity_str = "9.8";
+        float arrow_angle;             // degrees, with convention: 0=Up, 90=Right
+        sf::Vector2u window_size;
+
+        sf::RectangleShape speed_field_rect;
+        sf::RectangleShape angle_field_rect;
+        sf::RectangleShape gravity_field_rect;
+        sf::Text speed_label;
+        sf::Text angle_label;
+        sf::Text gravity_label;
+        sf::Text speed_text;
+        HudText angle_text;
+        sf::Text gravity_text;
+        sf::Text cursor_text;          // "|" after the field being edited
+        ActiveField active_field = kNoActiveField;
+
+        // Distance and height display
+        HudText distance_text;
+        HudText height_text;
+
+        // Angle arrow (positioned relative to the character) and the platform under the character
+        sf::Vector2f character_arrow_offset;
+        sf::ConvexShape arrow_shape;
+        sf::RectangleShape platform_rect;
+
+        // Fixed-timestep clock (see update)
+        float accumulator = 0.f;
+        float interpolation_alpha = 1.f;
+};
+
+// Adds the simulation (and its asset manifest) to the dashboard's menus
+void registerProjectileMotion(SimulationRegistry& registry);
 
-// Run the projectile motion simulation in a separate window or in the same window.
-// For simplicity, we'll create a new window here. 
-// You could also re-use the same window if desired.
-void runProjectileMotionSimulation();
+// The font and atlas the projectile scenes draw with (shared with StoredRunScene)
+const AssetManifest& getProjectileAssets();
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef PROJECTILE_SCENARIO_H
+#define PROJECTILE_SCENARIO_H
+
+//-------------------------------------------------------------------------------------------------
+// Projectile Motion Scenario
+//
+// Geometry and defaults shared by the interactive simulation (ProjectileMotion.cpp)
+// and the batch/headless tools. Both step a throw with Ball::update's arithmetic and
+// score it with checkBallStep (Ball.h), so they agree on every throw.
+// Pixel values are window coordinates; kScale converts them to meters.
+//-------------------------------------------------------------------------------------------------
+static const float kWindowWidth = 1920.f;
+static const float kWindowHeight = 1080.f;
+
+static const float kPhysicsHz = 240.f;           // Physics steps per second (independent of frame rate)
+static const float kPhysicsDt = 1.f / kPhysicsHz;
+
+static const float kGroundLineY = 800.f;         // Y coordinate for "ground"
+static const float kCharacterInitialX = 118.f;   // Initial 'x' position of character sprite
+static const float kCartInitialX = 1550.f;       // Initial 'x' position of cart sprite
+static const float kBallReleaseOffsetY = 251.f;  // Ball leaves this many pixels above the character's origin
+static const float kMaxLaunchHeight = 5.35f;     // Highest the character can be dragged (m above ground)
+
+static const float kDefaultSpeed = 11.5f;        // Default launch speed (m/s)
+static const float kDefaultGravity = 9.8f;       // Default gravity (m/s^2)
+static const float kDefaultAngleDeg = 45.0f;     // Default launch angle (degrees)
+
+static const float kScale = 100.f;               // Pixel-to-meter scale factor
+static const float kBasketRadius = 1.0f;         // Ball within this distance of the cart scores (m)
+
+// One throw, described the way the user sets it up on screen
+struct ProjectileLaunch {
+    float speed_m_s;        // launch speed
+    float angle_deg;        // 0 = right, 90 = straight up
+    float gravity;          // m/s^2, pulling down
+    float launch_height_m;  // character height above the ground (0 .. kMaxLaunchHeight)
+    float cart_distance_m;  // horizontal distance from the character to the cart
+};
+
+// Where a launch starts and what it is scored against, in meters (+y down, like Ball)
+struct ProjectileSetup {
+    float start_x_m, start_y_m;
+    float basket_x_m, basket_y_m;
+    float max_x_m, max_y_m;  // window bounds for Ball::advance
+};
+
+// Same conversion the simulation does from the character and cart sprites
+inline ProjectileSetup makeProjectileSetup(float launch_height_m, float cart_distance_m) {
+    const float character_y = kGroundLineY - launch_height_m * kScale;
+    const float cart_x = kCharacterInitialX + cart_distance_m * kScale;
+
+    ProjectileSetup setup;
+    setup.start_x_m = kCharacterInitialX / kScale;
+    setup.start_y_m = (character_y - kBallReleaseOffsetY) / kScale;
+    setup.basket_x_m = cart_x / kScale;
+    setup.basket_y_m = kGroundLineY / kScale;
+    setup.max_x_m = kWindowWidth / kScale;
+    setup.max_y_m = kWindowHeight / kScale;
+    return setup;
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include "ProjectileSolver.h"
+
+#include <cmath>
+#include <limits>
+
+//-------------------------------------------------------------------------------------------------
+// Polynomial Root Helpers (double precision; the answers are rounded to float at the end)
+//-------------------------------------------------------------------------------------------------
+static const double kEpsilon = 1e-12;
+
+// Real roots of a*t^2 + b*t + c = 0. Returns how many were written to roots[].
+static int solveQuadratic(double a, double b, double c, double roots[2]) {
+    if (std::fabs(a) < kEpsilon) {
+        if (std::fabs(b) < kEpsilon) return 0;
+        roots[0] = -c / b;
+        return 1;
+    }
+
+    double disc = b * b - 4.0 * a * c;
+    if (disc < 0.0) return 0;
+
+    // Numerically stable form (avoids subtracting two nearly equal numbers)
+    double q = -0.5 * (b + std::copysign(std::sqrt(disc), b));
+    roots[0] = q / a;
+    roots[1] = (std::fabs(q) < kEpsilon) ? roots[0] : c / q;
+    return 2;
+}
+
+// Real roots of a*t^3 + b*t^2 + c*t + d = 0. Returns how many were written to roots[].
+static int solveCubic(double a, double b, double c, double d, double roots[3]) {
+    if (std::fabs(a) < kEpsilon) {
+        return solveQuadratic(b, c, d, roots);
+    }
+
+    // Depressed cubic t = u - b/(3a):  u^3 + p*u + q = 0
+    const double pi = 3.14159265358979323846;
+    double B = b / a, C = c / a, D = d / a;
+    double shift = B / 3.0;
+    double p = C - B * B / 3.0;
+    double q = 2.0 * B * B * B / 27.0 - B * C / 3.0 + D;
+    double disc = q * q / 4.0 + p * p * p / 27.0;
+
+    if (disc > 0.0) {
+        // One real root (Cardano)
+        double s = std::sqrt(disc);
+        roots[0] = std::cbrt(-q / 2.0 + s) + std::cbrt(-q / 2.0 - s) - shift;
+        return 1;
+    }
+
+    if (std::fabs(p) < kEpsilon) {
+        roots[0] = std::cbrt(-q) - shift;
+        return 1;
+    }
+
+    // Three real roots (trigonometric form)
+    double r = 2.0 * std::sqrt(-p / 3.0);
+    double arg = 3.0 * q / (p * r);
+    if (arg > 1.0) arg = 1.0;
+    if (arg < -1.0) arg = -1.0;
+    double phi = std::acos(arg) / 3.0;
+    for (int k = 0; k < 3; ++k) {
+        roots[k] = r * std::cos(phi - 2.0 * pi * k / 3.0) - shift;
+    }
+    return 3;
+}
+
+// Smallest root of a*t^2 + b*t + c = 0 that is > 0, or infinity
+static double firstPositiveRoot(double a, double b, double c) {
+    double roots[2];
+    int count = solveQuadratic(a, b, c, roots);
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < count; ++i) {
+        if (roots[i] > 0.0 && roots[i] < best) best = roots[i];
+    }
+    return best;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Function: solveProjectile
+//
+// Description:
+//     The position of the ball is
+//         x(t) = x0 + vx*t
+//         y(t) = y0 + vy*t + g*t^2/2
+//     Exit time is the first root of x(t) = 0, x(t) = maxX, y(t) = 0 or y(t) = maxY.
+//     Closest approach minimizes |p(t) - basket|^2, whose derivative is a cubic in t,
+//     so the minimum is at one of its (at most 3) roots or at an end of [0, exit time].
+//-------------------------------------------------------------------------------------------------
+ProjectileOutcome solveProjectile(float x0_m, float y0_m, float vx_m_s, float vy_m_s, float g,
+    float basketX_m, float basketY_m, float threshold_m, float maxX_m, float maxY_m, float step_dt) {
+    const double inf = std::numeric_limits<double>::infinity();
+
+    const double x0 = x0_m, y0 = y0_m;
+    const double vx = vx_m_s;
+    const double vy = static_cast<double>(vy_m_s) + 0.5 * g * step_dt;
+    const double ay = g;
+
+    ProjectileOutcome out;
+
+    //-----------------------------------------------------------------------------
+    // Apex (highest point: smallest y)
+    //-----------------------------------------------------------------------------
+    if (vy < 0.0 && ay > 0.0) {
+        double t_apex = -vy / ay;
+        out.apex_time_s = static_cast<float>(t_apex);
+        out.apex_y_m = static_cast<float>(y0 + vy * t_apex + 0.5 * ay * t_apex * t_apex);
+    }
+    else {
+        out.apex_time_s = 0.f;
+        out.apex_y_m = y0_m;
+    }
+    out.apex_rise_m = y0_m - out.apex_y_m;
+
+    //-----------------------------------------------------------------------------
+    // Exit time and edge
+    //-----------------------------------------------------------------------------
+    double exit_time = inf;
+    ExitEdge exit_edge = ExitEdge::None;
+
+    if (x0 < 0.0 || x0 > maxX_m || y0 < 0.0 || y0 > maxY_m) {
+        // Already outside: Ball::isOutOfBounds would fire right away
+        exit_time = 0.0;
+        exit_edge = x0 < 0.0 ? ExitEdge::Left : x0 > maxX_m ? ExitEdge::Right
+            : y0 < 0.0 ? ExitEdge::Top : ExitEdge::Bottom;
+    }
+    else {
+        auto consider = [&](double t, ExitEdge edge) {
+            if (t > 0.0 && t < exit_time) {
+                exit_time = t;
+                exit_edge = edge;
+            }
+        };
+
+        if (vx > 0.0) consider((maxX_m - x0) / vx, ExitEdge::Right);
+        if (vx < 0.0) consider(-x0 / vx, ExitEdge::Left);
+
+        // y(t) = 0 crossed while moving up, y(t) = maxY crossed while moving down
+        double t_top = firstPositiveRoot(0.5 * ay, vy, y0);
+        if (t_top < inf && vy + ay * t_top < 0.0) consider(t_top, ExitEdge::Top);
+
+        double t_bottom = firstPositiveRoot(0.5 * ay, vy, y0 - maxY_m);
+        if (t_bottom < inf && vy + ay * t_bottom > 0.0) consider(t_bottom, ExitEdge::Bottom);
+    }
+
+    out.exit_time_s = static_cast<float>(exit_time);
+    out.exit_edge = exit_edge;
+
+    //-----------------------------------------------------------------------------
+    // Closest approach to the basket on [0, exit_time]
+    //
+    // d(t) = d0 + v*t + A*t^2 with A = (0, g/2)
+    // (1/2) d/dt |d|^2 = d . d' = 2|A|^2 t^3 + 3(A.v) t^2 + (|v|^2 + 2 d0.A) t + d0.v
+    //-----------------------------------------------------------------------------
+    const double dx0 = x0 - basketX_m;
+    const double dy0 = y0 - basketY_m;
+    const double Ay = 0.5 * ay;
+
+    auto distanceSqAt = [&](double t) {
+        double dx = dx0 + vx * t;
+        double dy = dy0 + vy * t + Ay * t * t;
+        return dx * dx + dy * dy;
+    };
+
+    double best_t = 0.0;
+    double best_d2 = distanceSqAt(0.0);
+    auto candidate = [&](double t) {
+        if (t < 0.0 || t > exit_time) return;
+        double d2 = distanceSqAt(t);
+        if (d2 < best_d2) {
+            best_d2 = d2;
+            best_t = t;
+        }
+    };
+
+    double roots[3];
+    int count = solveCubic(2.0 * Ay * Ay, 3.0 * Ay * vy, vx * vx + vy * vy + 2.0 * dy0 * Ay, dx0 * vx + dy0 * vy, roots);
+    for (int i = 0; i < count; ++i) candidate(roots[i]);
+    if (exit_time < inf) candidate(exit_time);
+
+    out.closest_time_s = static_cast<float>(best_t);
+    out.min_distance_m = static_cast<float>(std::sqrt(best_d2));
+    out.closest_x_m = static_cast<float>(x0 + vx * best_t);
+    out.closest_y_m = static_cast<float>(y0 + vy * best_t + Ay * best_t * best_t);
+    out.scored = out.min_distance_m < threshold_m;
+
+    return out;
+}
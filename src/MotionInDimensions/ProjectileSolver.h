@@ -0,0 +1,41 @@
+#pragma once
+#ifndef PROJECTILE_SOLVER_H
+#define PROJECTILE_SOLVER_H
+
+// Which window edge the ball leaves through (matches Ball::isOutOfBounds)
+enum class ExitEdge {
+    None,   // never leaves (e.g. zero gravity and zero velocity)
+    Left,   // x < 0
+    Right,  // x > maxX
+    Top,    // y < 0
+    Bottom  // y > maxY
+};
+
+// Everything about a drag-free throw, computed in closed form.
+// Coordinates are in meters with +y pointing down (same as Ball), times in seconds from launch.
+struct ProjectileOutcome {
+    bool scored;              // closest approach is within the threshold before the ball exits
+
+    float closest_time_s;     // time of closest approach to the basket (before exit)
+    float min_distance_m;     // distance to the basket at that time
+    float closest_x_m;
+    float closest_y_m;
+
+    float apex_time_s;        // time the ball is highest (0 if it never rises)
+    float apex_y_m;           // y at the apex (smallest y, since +y is down)
+    float apex_rise_m;        // how far above the launch point the apex is
+
+    float exit_time_s;        // first time the ball leaves the window (infinity if never)
+    ExitEdge exit_edge;
+};
+
+// Solves a throw from (x0, y0) with velocity (vx, vy) under constant gravity g (+y down)
+// without simulating it.
+//
+// step_dt = 0 gives the exact continuous parabola. Passing the physics step instead
+// (e.g. 1/240) gives the parabola that passes exactly through the positions Ball::update
+// produces: semi-implicit Euler samples the curve with a velocity offset of +g*dt/2.
+ProjectileOutcome solveProjectile(float x0_m, float y0_m, float vx_m_s, float vy_m_s, float g,
+    float basketX_m, float basketY_m, float threshold_m, float maxX_m, float maxY_m, float step_dt = 0.f);
+
+#endif
@@ -0,0 +1,240 @@
+#include "SessionRecording.h"
+#include "TraceCapture.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+//-------------------------------------------------------------------------------------------------
+// Binary Helpers
+//-------------------------------------------------------------------------------------------------
+namespace {
+    const char kMagic[8] = { 'P', 'H', 'Y', 'S', 'R', 'E', 'C', '1' };
+    const std::uint32_t kVersion = 1;
+
+    enum RecordTag : std::uint8_t {
+        kTagLaunch = 1,
+        kTagStep = 2,
+        kTagEnd = 3
+    };
+
+    // Fields are written one by one, so struct padding never reaches the file
+    template <typename T>
+    void writeValue(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::istream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    void writeBallState(std::ostream& out, const BallState& state) {
+        writeValue(out, state.x_m);
+        writeValue(out, state.y_m);
+        writeValue(out, state.prev_x_m);
+        writeValue(out, state.prev_y_m);
+        writeValue(out, state.vx_m_s);
+        writeValue(out, state.vy_m_s);
+    }
+
+    bool readBallState(std::istream& in, BallState& state) {
+        return readValue(in, state.x_m) && readValue(in, state.y_m)
+            && readValue(in, state.prev_x_m) && readValue(in, state.prev_y_m)
+            && readValue(in, state.vx_m_s) && readValue(in, state.vy_m_s);
+    }
+
+    bool sameBits(const BallState& a, const BallState& b) {
+        return std::memcmp(&a, &b, sizeof(BallState)) == 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Recorder
+//-------------------------------------------------------------------------------------------------
+bool SessionRecorder::open(const std::string& path, float physics_dt) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out.write(kMagic, sizeof(kMagic));
+    writeValue(out, kVersion);
+    writeValue(out, physics_dt);
+    return static_cast<bool>(out);
+}
+
+void SessionRecorder::close() {
+    if (out.is_open()) {
+        out.close();
+    }
+}
+
+void SessionRecorder::recordLaunch(const RecordedLaunch& launch) {
+    if (!out.is_open()) return;
+    writeValue(out, static_cast<std::uint8_t>(kTagLaunch));
+    writeValue(out, launch.frame);
+    writeValue(out, launch.start_x_m);
+    writeValue(out, launch.start_y_m);
+    writeValue(out, launch.speed_m_s);
+    writeValue(out, launch.angle_deg);
+    writeValue(out, launch.gravity);
+    writeValue(out, launch.basket_x_m);
+    writeValue(out, launch.basket_y_m);
+    writeValue(out, launch.threshold_m);
+    writeValue(out, launch.max_x_m);
+    writeValue(out, launch.max_y_m);
+}
+
+void SessionRecorder::recordStep(const BallState& state) {
+    if (!out.is_open()) return;
+    writeValue(out, static_cast<std::uint8_t>(kTagStep));
+    writeBallState(out, state);
+}
+
+void SessionRecorder::recordEnd(BallStepResult result, std::uint32_t steps) {
+    if (!out.is_open()) return;
+    writeValue(out, static_cast<std::uint8_t>(kTagEnd));
+    writeValue(out, static_cast<std::uint8_t>(result));
+    writeValue(out, steps);
+    out.flush();
+}
+
+//-------------------------------------------------------------------------------------------------
+// Loading
+//-------------------------------------------------------------------------------------------------
+bool loadSession(const std::string& path, RecordedSession& session, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "could not open '" + path + "'";
+        return false;
+    }
+
+    char magic[sizeof(kMagic)];
+    std::uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        error = "not a session recording";
+        return false;
+    }
+    if (!readValue(in, version) || version != kVersion) {
+        error = "unsupported recording version " + std::to_string(version);
+        return false;
+    }
+    session = RecordedSession();
+    if (!readValue(in, session.physics_dt)) {
+        error = "truncated header";
+        return false;
+    }
+
+    for (;;) {
+        const long long record_start = static_cast<long long>(in.tellg());
+        std::uint8_t tag;
+        if (!readValue(in, tag)) {
+            break;
+        }
+
+        bool ok = false;
+        switch (tag) {
+        case kTagLaunch: {
+            RecordedThrow thrown;
+            RecordedLaunch& l = thrown.launch;
+            ok = readValue(in, l.frame) && readValue(in, l.start_x_m) && readValue(in, l.start_y_m)
+                && readValue(in, l.speed_m_s) && readValue(in, l.angle_deg) && readValue(in, l.gravity)
+                && readValue(in, l.basket_x_m) && readValue(in, l.basket_y_m) && readValue(in, l.threshold_m)
+                && readValue(in, l.max_x_m) && readValue(in, l.max_y_m);
+            if (ok) session.throws.push_back(thrown);
+            break;
+        }
+        case kTagStep: {
+            BallState state;
+            ok = !session.throws.empty() && readBallState(in, state);
+            if (ok) session.throws.back().steps.push_back(state);
+            break;
+        }
+        case kTagEnd: {
+            std::uint8_t result;
+            std::uint32_t steps;
+            ok = !session.throws.empty() && readValue(in, result) && readValue(in, steps)
+                && steps == session.throws.back().steps.size();
+            if (ok) {
+                session.throws.back().finished = true;
+                session.throws.back().result = static_cast<BallStepResult>(result);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!ok) {
+            error = "corrupt or truncated record at byte " + std::to_string(record_start);
+            return false;
+        }
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Replay
+//-------------------------------------------------------------------------------------------------
+ReplayReport replaySession(const RecordedSession& session) {
+    ReplayReport report;
+    report.throws = session.throws.size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < session.throws.size(); ++t) {
+        TraceZone zone("Replay throw");
+        const RecordedThrow& recorded = session.throws[t];
+        const RecordedLaunch& l = recorded.launch;
+        Ball ball(l.start_x_m, l.start_y_m, l.speed_m_s, l.angle_deg, l.gravity);
+
+        bool matches = true;
+        std::size_t mismatch_step = 0;
+        BallStepResult result = BallStepResult::Flying;
+        for (std::size_t i = 0; i < recorded.steps.size(); ++i) {
+            result = ball.advance(session.physics_dt, l.basket_x_m, l.basket_y_m, l.threshold_m, l.max_x_m, l.max_y_m);
+            ++report.steps;
+
+            // The throw must not end earlier than recorded, and every state must be identical
+            bool last = i + 1 == recorded.steps.size();
+            if (!sameBits(ball.getState(), recorded.steps[i]) || (result != BallStepResult::Flying && !last)) {
+                matches = false;
+                mismatch_step = i;
+                break;
+            }
+        }
+
+        // ...and it must end where the recording says it did
+        if (matches && recorded.finished && result != recorded.result) {
+            matches = false;
+            mismatch_step = recorded.steps.empty() ? 0 : recorded.steps.size() - 1;
+        }
+
+        if (!matches) {
+            if (report.mismatched_throws == 0) {
+                report.first_mismatch_throw = t;
+                report.first_mismatch_step = mismatch_step;
+            }
+            ++report.mismatched_throws;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    report.seconds = std::chrono::duration<double>(end - start).count();
+    report.steps_per_second = report.seconds > 0.0 ? report.steps / report.seconds : 0.0;
+    return report;
+}
+
+void writeReplayReport(const ReplayReport& report, std::ostream& out) {
+    out << "Replay: " << report.throws << " throws, "
+        << report.steps << " physics steps\n";
+    if (report.mismatched_throws == 0) {
+        out << "  all trajectories bit-identical\n";
+    }
+    else {
+        out << "  " << report.mismatched_throws << " throw(s) differ, first at throw "
+            << report.first_mismatch_throw << ", step " << report.first_mismatch_step << "\n";
+    }
+    out << std::fixed << std::setprecision(2);
+    out << "  " << report.steps_per_second / 1e6 << " M steps/s (" << std::setprecision(4)
+        << report.seconds << " s)\n";
+}
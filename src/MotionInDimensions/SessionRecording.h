@@ -0,0 +1,88 @@
+#pragma once
+#ifndef SESSION_RECORDING_H
+#define SESSION_RECORDING_H
+
+#include "Ball.h"
+#include "BallState.h"
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Session Recording
+//
+// A compact binary log of a projectile session: for every throw, its launch parameters
+// and the BallState after every physics step. Replay is launch-based: it re-runs each
+// recorded launch headless at full speed and checks the trajectory is bit-identical to
+// the recording. The drags and text entry that set a launch up are not recorded, since
+// only the window's widgets can turn them into launch parameters.
+//
+// File layout (native byte order, i.e. little-endian on x86/x64; no padding):
+//     header:  "PHYSREC1"  u32 version  f32 physics_dt
+//     records: u8 tag, then
+//         Launch  u32 frame  f32 x10 (see RecordedLaunch)
+//         Step    f32 x6     (BallState)
+//         End     u8 result  u32 steps
+//-------------------------------------------------------------------------------------------------
+
+// Everything a throw needs to be re-run (meters, m/s, degrees, m/s^2)
+struct RecordedLaunch {
+    std::uint32_t frame;
+    float start_x_m, start_y_m;
+    float speed_m_s, angle_deg, gravity;
+    float basket_x_m, basket_y_m, threshold_m;
+    float max_x_m, max_y_m;
+};
+
+struct RecordedThrow {
+    RecordedLaunch launch;
+    std::vector<BallState> steps;               // state after each physics step
+    bool finished = false;                      // false if the window closed mid-flight
+    BallStepResult result = BallStepResult::Flying;
+};
+
+struct RecordedSession {
+    float physics_dt = 0.f;
+    std::vector<RecordedThrow> throws;
+};
+
+// Writes a session as it happens. All record calls do nothing until open() succeeds.
+class SessionRecorder {
+    public:
+        bool open(const std::string& path, float physics_dt);
+        bool isOpen() const { return out.is_open(); }
+        void close();
+
+        void recordLaunch(const RecordedLaunch& launch);
+        void recordStep(const BallState& state);
+        void recordEnd(BallStepResult result, std::uint32_t steps);
+
+    private:
+        std::ofstream out;
+};
+
+// Reads a whole recording. On failure returns false and describes the problem in "error".
+bool loadSession(const std::string& path, RecordedSession& session, std::string& error);
+
+struct ReplayReport {
+    std::size_t throws = 0;
+    std::size_t steps = 0;                  // physics steps re-run
+    std::size_t mismatched_throws = 0;      // throws whose trajectory or result differs
+
+    // First difference found (only valid if mismatched_throws > 0)
+    std::size_t first_mismatch_throw = 0;
+    std::size_t first_mismatch_step = 0;
+
+    double seconds = 0.0;
+    double steps_per_second = 0.0;
+};
+
+// Re-runs every recorded throw with Ball::advance and compares each step bit for bit
+ReplayReport replaySession(const RecordedSession& session);
+
+void writeReplayReport(const ReplayReport& report, std::ostream& out);
+
+#endif
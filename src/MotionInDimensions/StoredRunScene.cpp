@@ -0,0 +1,176 @@
+#include "StoredRunScene.h"
+#include "ProjectileMotion.h"
+#include "ProjectileScenario.h"
+#include "SimulationRegistry.h"
+
+#include <cstdio>
+
+static const float kMaxFrameTime = 0.25f; // Longest real frame time (s) played in one frame
+
+StoredRunScene::StoredRunScene(SceneStack& stack, const std::string& storePath, std::size_t runIndex)
+    : stack(stack), store_path(storePath), run_index(runIndex)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+// Function: load
+//-------------------------------------------------------------------------------------------------
+bool StoredRunScene::load(std::string& error) {
+    if (!store.open(store_path, error)) {
+        return false;
+    }
+    if (store.getRunCount() == 0) {
+        error = "'" + store_path + "' holds no runs";
+        return false;
+    }
+    if (run_index >= store.getRunCount()) {
+        error = "run " + std::to_string(run_index) + " is out of range";
+        return false;
+    }
+
+    // Same font and atlas as the projectile simulation
+    const AssetManifest& assets = getProjectileAssets();
+    font = ResourceCache<sf::Font>::getDefault().load(assets.fonts.front(), error);
+    if (!font) {
+        return false;
+    }
+    atlas = loadAtlas(assets.atlases.front(), error);
+    if (!atlas) {
+        return false;
+    }
+
+    const sf::Vector2u window_size = stack.getWindow().getSize();
+    sprite_background = atlas->makeSprite("background");
+    {
+        sf::FloatRect texture_size = sprite_background.getLocalBounds();
+        sprite_background.setScale(static_cast<float>(window_size.x) / texture_size.width,
+            static_cast<float>(window_size.y) / texture_size.height);
+    }
+
+    sprite_character = atlas->makeSprite("character");
+    {
+        sf::FloatRect char_bounds = sprite_character.getLocalBounds();
+        sprite_character.setOrigin(char_bounds.width / 2.f, char_bounds.height / 2.f);
+    }
+
+    sprite_cart = atlas->makeSprite("cart");
+    {
+        sf::FloatRect cart_bounds = sprite_cart.getLocalBounds();
+        sprite_cart.setOrigin(cart_bounds.width / 2.f, cart_bounds.height / 2.f);
+    }
+
+    sf::Sprite sprite_ball = atlas->makeSprite("ball");
+    sprite_ball.setScale(0.25f, 0.25f);
+    {
+        sf::FloatRect ball_bounds = sprite_ball.getLocalBounds();
+        sprite_ball.setOrigin(ball_bounds.width / 2.f, ball_bounds.height / 2.f);
+    }
+    ball_sprite.setSprite(sprite_ball);
+
+    run_text.getText() = sf::Text("", *font, 30);
+    run_text.getText().setFillColor(sf::Color::Yellow);
+    run_text.getText().setPosition(50.f, 50.f);
+
+    showRun(run_index);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Function: showRun
+//
+// Description:
+//     Places the character and cart for the run's launch (as makeProjectileSetup does) and
+//     starts playing it from the launch.
+//-------------------------------------------------------------------------------------------------
+void StoredRunScene::showRun(std::size_t index) {
+    run_index = index;
+    run = store.getRun(index);
+
+    sprite_character.setPosition(kCharacterInitialX, kGroundLineY - run.launch.launch_height_m * kScale);
+    sprite_cart.setPosition(kCharacterInitialX + run.launch.cart_distance_m * kScale, kGroundLineY);
+
+    const char* outcome = run.outcome == LaunchOutcome::Scored ? "Goal!"
+        : run.outcome == LaunchOutcome::OutOfBounds ? "No Goal!" : "Timed out";
+    char line[HudText::kMaxLength + 1];
+    int length = std::snprintf(line, sizeof(line), "Run %zu of %llu: %.2f m/s at %.1f deg, %s",
+        index, static_cast<unsigned long long>(store.getRunCount()), run.launch.speed_m_s, run.launch.angle_deg, outcome);
+    run_text.setString(line, length > 0 ? static_cast<std::size_t>(length) : 0);
+
+    time_s = 0.f;
+    sample = 0;
+    playing = run.sample_count > 1;
+    stack.invalidate();
+}
+
+//-------------------------------------------------------------------------------------------------
+// Event Handling
+//-------------------------------------------------------------------------------------------------
+void StoredRunScene::handleEvent(const sf::Event& event) {
+    if (event.type != sf::Event::KeyPressed) {
+        return;
+    }
+
+    switch (event.key.code) {
+    case sf::Keyboard::Escape:
+        stack.pop();
+        break;
+    case sf::Keyboard::Left:
+        showRun(run_index > 0 ? run_index - 1 : static_cast<std::size_t>(store.getRunCount() - 1));
+        break;
+    case sf::Keyboard::Right:
+        showRun(run_index + 1 < store.getRunCount() ? run_index + 1 : 0);
+        break;
+    case sf::Keyboard::Space:
+        showRun(run_index);
+        break;
+    default:
+        break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Playback
+//-------------------------------------------------------------------------------------------------
+void StoredRunScene::update(float frameTime) {
+    if (!playing) {
+        return;
+    }
+
+    time_s += frameTime < kMaxFrameTime ? frameTime : kMaxFrameTime;
+    while (sample + 1 < run.sample_count && run.t_s[sample + 1] <= time_s) {
+        ++sample;
+    }
+    if (sample + 1 >= run.sample_count) {
+        playing = false; // shows the last sample, where the run ended
+    }
+}
+
+void StoredRunScene::draw(sf::RenderWindow& window, SpriteBatch& batch) {
+    batch.draw(sprite_background);
+    batch.draw(sprite_character);
+    batch.draw(sprite_cart);
+
+    // Between the last passed sample and the next one, like the simulation interpolates
+    // between physics steps
+    if (run.sample_count > 0) {
+        const std::size_t next = sample + 1 < run.sample_count ? sample + 1 : sample;
+        BallState state;
+        state.prev_x_m = run.x_m[sample];
+        state.prev_y_m = run.y_m[sample];
+        state.x_m = run.x_m[next];
+        state.y_m = run.y_m[next];
+        state.vx_m_s = run.vx_m_s[next];
+        state.vy_m_s = run.vy_m_s[next];
+
+        float alpha = 1.f;
+        const float span = run.t_s[next] - run.t_s[sample];
+        if (span > 0.f) {
+            alpha = (time_s - run.t_s[sample]) / span;
+            alpha = alpha < 0.f ? 0.f : (alpha > 1.f ? 1.f : alpha);
+        }
+        ball_sprite.sync(state, alpha);
+        ball_sprite.draw(batch);
+    }
+
+    batch.draw(window, run_text.getText());
+}
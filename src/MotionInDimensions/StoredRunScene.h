@@ -0,0 +1,54 @@
+#pragma once
+#include "Scene.h"
+#include "BallSprite.h"
+#include "HudText.h"
+#include "ResourceCache.h"
+#include "TextureAtlas.h"
+#include "TrajectoryStore.h"
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string>
+
+// Plays the runs of a columnar trajectory store (physim-headless sweep --store) in the
+// projectile scene: the character and cart stand where the run's launch put them, and the
+// ball follows the stored samples in real time. The samples are read straight from the
+// mapped file. Left/Right pick the previous/next run, Space plays the run again and
+// Escape goes back.
+class StoredRunScene : public Scene {
+    public:
+        StoredRunScene(SceneStack& stack, const std::string& storePath, std::size_t runIndex = 0);
+
+        // Opens the store and gets the font and textures from the shared caches. Call it
+        // before pushing the scene.
+        bool load(std::string& error);
+
+        const char* getTitle() const override { return "Stored Run Viewer"; }
+        void handleEvent(const sf::Event& event) override;
+        bool isAnimating() const override { return playing; }
+        void update(float frameTime) override;
+        void draw(sf::RenderWindow& window, SpriteBatch& batch) override;
+
+    private:
+        void showRun(std::size_t index);
+
+        SceneStack& stack;
+        std::string store_path;
+        TrajectoryStoreReader store;
+
+        ResourceCache<sf::Font>::Handle font;
+        ResourceCache<TextureAtlas>::Handle atlas;
+
+        sf::Sprite sprite_background;
+        sf::Sprite sprite_character;
+        sf::Sprite sprite_cart;
+        BallSprite ball_sprite;
+        HudText run_text;
+
+        // Playback of the current run
+        std::size_t run_index;
+        StoredRun run = {};
+        float time_s = 0.f;         // playback time since launch
+        std::size_t sample = 0;     // last sample at or before time_s
+        bool playing = false;
+};
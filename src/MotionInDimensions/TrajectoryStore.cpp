@@ -0,0 +1,306 @@
+#include "TrajectoryStore.h"
+#include "TraceCapture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Layout
+//-------------------------------------------------------------------------------------------------
+namespace {
+    const char kMagic[8] = { 'P', 'H', 'Y', 'S', 'C', 'O', 'L', '1' };
+    const std::uint32_t kVersion = 1;
+    const int kColumnCount = static_cast<int>(StoreColumn::Count);
+    const int kFirstSampleColumn = static_cast<int>(StoreColumn::SampleTime);
+    const std::uint64_t kColumnAlignment = 64;
+
+    // Starting capacities of a new store
+    const std::uint64_t kInitialRuns = 1024;
+    const std::uint64_t kInitialSamples = 1 << 18;
+
+    // Launches traced per batch in writeSweepStore
+    const std::size_t kSweepBatch = 2048;
+
+    std::uint64_t getElementSize(int column) {
+        return column == static_cast<int>(StoreColumn::RunFirstSample) ? 8 : 4;
+    }
+
+    bool isRunColumn(int column) {
+        return column < kFirstSampleColumn;
+    }
+
+    std::uint64_t alignUp(std::uint64_t value) {
+        return (value + kColumnAlignment - 1) & ~(kColumnAlignment - 1);
+    }
+
+    // Fills in the column offsets for the given capacities and returns the file size
+    std::uint64_t computeLayout(std::uint64_t run_capacity, std::uint64_t sample_capacity, std::uint64_t* offsets) {
+        std::uint64_t offset = sizeof(TrajectoryStoreHeader);
+        for (int c = 0; c < kColumnCount; ++c) {
+            offset = alignUp(offset);
+            offsets[c] = offset;
+            offset += (isRunColumn(c) ? run_capacity : sample_capacity) * getElementSize(c);
+        }
+        return alignUp(offset);
+    }
+
+    template <typename T>
+    T* getColumnData(std::uint8_t* base, const TrajectoryStoreHeader& header, StoreColumn column) {
+        return reinterpret_cast<T*>(base + header.column_offsets[static_cast<int>(column)]);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Writer
+//-------------------------------------------------------------------------------------------------
+TrajectoryStoreWriter::~TrajectoryStoreWriter() {
+    close();
+}
+
+TrajectoryStoreHeader& TrajectoryStoreWriter::header() {
+    return *reinterpret_cast<TrajectoryStoreHeader*>(file.data());
+}
+
+const TrajectoryStoreHeader& TrajectoryStoreWriter::header() const {
+    return *reinterpret_cast<const TrajectoryStoreHeader*>(file.data());
+}
+
+std::uint64_t TrajectoryStoreWriter::getRunCount() const {
+    return file.isOpen() ? header().run_count : 0;
+}
+
+std::uint64_t TrajectoryStoreWriter::getSampleCount() const {
+    return file.isOpen() ? header().sample_count : 0;
+}
+
+bool TrajectoryStoreWriter::create(const std::string& path, float physics_dt, std::string& error) {
+    close();
+
+    TrajectoryStoreHeader fresh = {};
+    std::memcpy(fresh.magic, kMagic, sizeof(kMagic));
+    fresh.version = kVersion;
+    fresh.header_bytes = sizeof(TrajectoryStoreHeader);
+    fresh.physics_dt = physics_dt;
+    fresh.column_count = kColumnCount;
+    fresh.run_capacity = kInitialRuns;
+    fresh.sample_capacity = kInitialSamples;
+    std::uint64_t size = computeLayout(kInitialRuns, kInitialSamples, fresh.column_offsets);
+
+    if (!file.open(path, MappedFile::Mode::Create, static_cast<std::size_t>(size))) {
+        error = "could not create '" + path + "'";
+        return false;
+    }
+    header() = fresh;
+    return true;
+}
+
+bool TrajectoryStoreWriter::openForAppend(const std::string& path, std::string& error) {
+    close();
+
+    // Validate with the reader first, then map it writable
+    TrajectoryStoreReader check;
+    if (!check.open(path, error)) {
+        return false;
+    }
+    check.close();
+
+    if (!file.open(path, MappedFile::Mode::ReadWrite)) {
+        error = "could not open '" + path + "' for writing";
+        return false;
+    }
+    return true;
+}
+
+bool TrajectoryStoreWriter::relayout(std::uint64_t run_capacity, std::uint64_t sample_capacity) {
+    TrajectoryStoreHeader old_header = header();
+    std::uint64_t new_offsets[kColumnCount];
+    std::uint64_t new_size = computeLayout(run_capacity, sample_capacity, new_offsets);
+    const bool growing = new_size > file.size();
+
+    if (growing && !file.resize(static_cast<std::size_t>(new_size))) {
+        return false;
+    }
+
+    // Move only the used part of each column. Columns move towards the end of the file
+    // when growing (so go from the last one back) and towards the start when packing.
+    std::uint8_t* base = file.data();
+    for (int i = 0; i < kColumnCount; ++i) {
+        int c = growing ? kColumnCount - 1 - i : i;
+        std::uint64_t used = isRunColumn(c) ? old_header.run_count : old_header.sample_count;
+        if (new_offsets[c] != old_header.column_offsets[c] && used > 0) {
+            std::memmove(base + new_offsets[c], base + old_header.column_offsets[c],
+                static_cast<std::size_t>(used * getElementSize(c)));
+        }
+    }
+
+    TrajectoryStoreHeader& h = header();
+    std::memcpy(h.column_offsets, new_offsets, sizeof(new_offsets));
+    h.run_capacity = run_capacity;
+    h.sample_capacity = sample_capacity;
+
+    if (!growing && !file.resize(static_cast<std::size_t>(new_size))) {
+        return false;
+    }
+    return true;
+}
+
+bool TrajectoryStoreWriter::reserve(std::uint64_t runs, std::uint64_t samples) {
+    const TrajectoryStoreHeader& h = header();
+    if (runs <= h.run_capacity && samples <= h.sample_capacity) {
+        return true;
+    }
+    return relayout(std::max(runs, h.run_capacity * 2), std::max(samples, h.sample_capacity * 2));
+}
+
+bool TrajectoryStoreWriter::appendRun(const ProjectileLaunch& launch, LaunchOutcome outcome, const LaunchTrace& trace) {
+    if (!file.isOpen()) {
+        return false;
+    }
+
+    const std::uint64_t run = header().run_count;
+    const std::uint64_t first = header().sample_count;
+    const std::size_t count = trace.size();
+    if (!reserve(run + 1, first + count)) {
+        return false;
+    }
+
+    std::uint8_t* base = file.data();
+    const TrajectoryStoreHeader& h = header();
+
+    // Samples
+    const std::size_t bytes = count * sizeof(float);
+    if (count > 0) {
+        std::memcpy(getColumnData<float>(base, h, StoreColumn::SampleTime) + first, trace.t_s.data(), bytes);
+        std::memcpy(getColumnData<float>(base, h, StoreColumn::SampleX) + first, trace.x_m.data(), bytes);
+        std::memcpy(getColumnData<float>(base, h, StoreColumn::SampleY) + first, trace.y_m.data(), bytes);
+        std::memcpy(getColumnData<float>(base, h, StoreColumn::SampleVx) + first, trace.vx_m_s.data(), bytes);
+        std::memcpy(getColumnData<float>(base, h, StoreColumn::SampleVy) + first, trace.vy_m_s.data(), bytes);
+    }
+
+    // Run index entry
+    getColumnData<std::uint64_t>(base, h, StoreColumn::RunFirstSample)[run] = first;
+    getColumnData<std::uint32_t>(base, h, StoreColumn::RunSampleCount)[run] = static_cast<std::uint32_t>(count);
+    getColumnData<std::uint32_t>(base, h, StoreColumn::RunOutcome)[run] = static_cast<std::uint32_t>(outcome);
+    getColumnData<float>(base, h, StoreColumn::RunSpeed)[run] = launch.speed_m_s;
+    getColumnData<float>(base, h, StoreColumn::RunAngle)[run] = launch.angle_deg;
+    getColumnData<float>(base, h, StoreColumn::RunGravity)[run] = launch.gravity;
+    getColumnData<float>(base, h, StoreColumn::RunLaunchHeight)[run] = launch.launch_height_m;
+    getColumnData<float>(base, h, StoreColumn::RunCartDistance)[run] = launch.cart_distance_m;
+
+    // Publish the run last
+    header().sample_count = first + count;
+    header().run_count = run + 1;
+    return true;
+}
+
+bool TrajectoryStoreWriter::close() {
+    if (!file.isOpen()) {
+        return true;
+    }
+    const TrajectoryStoreHeader& h = header();
+    bool ok = relayout(std::max<std::uint64_t>(h.run_count, 1), std::max<std::uint64_t>(h.sample_count, 1)) && file.flush();
+    file.close();
+    return ok;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Reader
+//-------------------------------------------------------------------------------------------------
+const TrajectoryStoreHeader& TrajectoryStoreReader::header() const {
+    return *reinterpret_cast<const TrajectoryStoreHeader*>(file.data());
+}
+
+bool TrajectoryStoreReader::open(const std::string& path, std::string& error) {
+    if (!file.open(path, MappedFile::Mode::ReadOnly)) {
+        error = "could not open '" + path + "'";
+        return false;
+    }
+
+    auto fail = [&](const char* problem) {
+        error = "'" + path + "': " + problem;
+        file.close();
+        return false;
+    };
+
+    if (file.size() < sizeof(TrajectoryStoreHeader)) return fail("too small to be a trajectory store");
+    const TrajectoryStoreHeader& h = header();
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) return fail("not a trajectory store");
+    if (h.version != kVersion || h.header_bytes != sizeof(TrajectoryStoreHeader) || h.column_count != kColumnCount) {
+        return fail("unsupported trajectory store version");
+    }
+    if (h.run_count > h.run_capacity || h.sample_count > h.sample_capacity) return fail("corrupt header");
+
+    // Every column has to fit in the file
+    for (int c = 0; c < kColumnCount; ++c) {
+        std::uint64_t capacity = isRunColumn(c) ? h.run_capacity : h.sample_capacity;
+        if (h.column_offsets[c] % kColumnAlignment != 0 || h.column_offsets[c] < sizeof(TrajectoryStoreHeader)
+            || capacity > (file.size() - h.column_offsets[c]) / getElementSize(c)) {
+            return fail("column outside the file");
+        }
+    }
+
+    // ...and every run has to point at samples that exist
+    const std::uint64_t* first = static_cast<const std::uint64_t*>(getColumn(StoreColumn::RunFirstSample));
+    const std::uint32_t* count = static_cast<const std::uint32_t*>(getColumn(StoreColumn::RunSampleCount));
+    for (std::uint64_t r = 0; r < h.run_count; ++r) {
+        if (first[r] > h.sample_count || count[r] > h.sample_count - first[r]) {
+            return fail("run index points outside the samples");
+        }
+    }
+    return true;
+}
+
+const void* TrajectoryStoreReader::getColumn(StoreColumn column) const {
+    return file.data() + header().column_offsets[static_cast<int>(column)];
+}
+
+StoredRun TrajectoryStoreReader::getRun(std::size_t index) const {
+    auto column = [this](StoreColumn c) { return static_cast<const float*>(getColumn(c)); };
+    const std::uint64_t first = static_cast<const std::uint64_t*>(getColumn(StoreColumn::RunFirstSample))[index];
+
+    StoredRun run;
+    run.launch.speed_m_s = column(StoreColumn::RunSpeed)[index];
+    run.launch.angle_deg = column(StoreColumn::RunAngle)[index];
+    run.launch.gravity = column(StoreColumn::RunGravity)[index];
+    run.launch.launch_height_m = column(StoreColumn::RunLaunchHeight)[index];
+    run.launch.cart_distance_m = column(StoreColumn::RunCartDistance)[index];
+    run.outcome = static_cast<LaunchOutcome>(static_cast<const std::uint32_t*>(getColumn(StoreColumn::RunOutcome))[index]);
+    run.sample_count = static_cast<const std::uint32_t*>(getColumn(StoreColumn::RunSampleCount))[index];
+    run.t_s = column(StoreColumn::SampleTime) + first;
+    run.x_m = column(StoreColumn::SampleX) + first;
+    run.y_m = column(StoreColumn::SampleY) + first;
+    run.vx_m_s = column(StoreColumn::SampleVx) + first;
+    run.vy_m_s = column(StoreColumn::SampleVy) + first;
+    return run;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Sweep Output
+//-------------------------------------------------------------------------------------------------
+bool writeSweepStore(const LaunchSweepConfig& config, TaskScheduler& scheduler, TrajectoryStoreWriter& store) {
+    std::vector<ProjectileLaunch> launches(kSweepBatch);
+    std::vector<LaunchOutcome> outcomes(kSweepBatch);
+    std::vector<LaunchTrace> traces(kSweepBatch);
+
+    // Trace a batch in parallel, then append it in launch order
+    for (std::size_t batch_begin = 0; batch_begin < config.launches; batch_begin += kSweepBatch) {
+        const std::size_t batch_size = std::min(kSweepBatch, config.launches - batch_begin);
+
+        scheduler.parallelFor(0, batch_size, 16, [&](std::size_t begin, std::size_t end) {
+            TraceZone zone("Trace launches");
+            for (std::size_t i = begin; i < end; ++i) {
+                launches[i] = sampleLaunch(config, batch_begin + i);
+                outcomes[i] = traceLaunch(launches[i], config.dt, config.max_steps, traces[i]);
+            }
+        });
+
+        TraceZone append_zone("Append batch");
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            if (!store.appendRun(launches[i], outcomes[i], traces[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,139 @@
+#pragma once
+#ifndef TRAJECTORY_STORE_H
+#define TRAJECTORY_STORE_H
+
+#include "LaunchSweep.h"
+#include "MappedFile.h"
+#include "TaskScheduler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//-------------------------------------------------------------------------------------------------
+// Columnar Trajectory Store
+//
+// On-disk format for the trajectories of very large sweeps. The file is memory-mapped,
+// so it can be far bigger than RAM. Each field has its own contiguous column, so an
+// analysis that only needs, say, x and y reads only those pages.
+//
+// Layout (native byte order, every column starts on a 64-byte boundary):
+//     TrajectoryStoreHeader (256 bytes)
+//     run columns     one entry per run: first sample, sample count, outcome and the
+//                     launch parameters (the per-run offset index)
+//     sample columns  one entry per sample: t, x, y, vx, vy; a run's samples are
+//                     [first_sample, first_sample + sample_count)
+//
+// While a file is open for writing, its columns have spare capacity and grow by
+// doubling (the columns are moved inside the mapped file). close() packs them
+// together again and trims the file. Runs are appended one at a time, and the header
+// counts are only bumped after a run's data is in place.
+//-------------------------------------------------------------------------------------------------
+
+enum class StoreColumn {
+    // Per run
+    RunFirstSample,   // u64
+    RunSampleCount,   // u32
+    RunOutcome,       // u32 (LaunchOutcome)
+    RunSpeed,         // f32 m/s
+    RunAngle,         // f32 degrees
+    RunGravity,       // f32 m/s^2
+    RunLaunchHeight,  // f32 m
+    RunCartDistance,  // f32 m
+    // Per sample
+    SampleTime,       // f32 s since launch
+    SampleX,          // f32 m
+    SampleY,          // f32 m
+    SampleVx,         // f32 m/s
+    SampleVy,         // f32 m/s
+    Count
+};
+
+struct TrajectoryStoreHeader {
+    char magic[8];                    // "PHYSCOL1"
+    std::uint32_t version;
+    std::uint32_t header_bytes;
+    float physics_dt;
+    std::uint32_t column_count;
+    std::uint64_t run_count;
+    std::uint64_t run_capacity;
+    std::uint64_t sample_count;
+    std::uint64_t sample_capacity;
+    std::uint64_t column_offsets[static_cast<int>(StoreColumn::Count)];
+    std::uint8_t reserved[96];
+};
+
+static_assert(sizeof(TrajectoryStoreHeader) == 256, "TrajectoryStoreHeader is part of the file format");
+
+// Appends runs to a store file
+class TrajectoryStoreWriter {
+    public:
+        TrajectoryStoreWriter() = default;
+        ~TrajectoryStoreWriter();
+
+        TrajectoryStoreWriter(const TrajectoryStoreWriter&) = delete;
+        TrajectoryStoreWriter& operator=(const TrajectoryStoreWriter&) = delete;
+
+        // Starts a new, empty store
+        bool create(const std::string& path, float physics_dt, std::string& error);
+
+        // Opens an existing store to add more runs to it
+        bool openForAppend(const std::string& path, std::string& error);
+
+        bool appendRun(const ProjectileLaunch& launch, LaunchOutcome outcome, const LaunchTrace& trace);
+
+        // Packs the columns, trims the file and closes it
+        bool close();
+
+        bool isOpen() const { return file.isOpen(); }
+        std::uint64_t getRunCount() const;
+        std::uint64_t getSampleCount() const;
+
+    private:
+        bool reserve(std::uint64_t runs, std::uint64_t samples);
+        bool relayout(std::uint64_t run_capacity, std::uint64_t sample_capacity);
+        TrajectoryStoreHeader& header();
+        const TrajectoryStoreHeader& header() const;
+
+        MappedFile file;
+};
+
+// One run of a store. The arrays point straight into the mapped file (zero-copy).
+struct StoredRun {
+    ProjectileLaunch launch;
+    LaunchOutcome outcome;
+    std::size_t sample_count;
+    const float* t_s;
+    const float* x_m;
+    const float* y_m;
+    const float* vx_m_s;
+    const float* vy_m_s;
+};
+
+// Read-only, zero-copy view of a store file
+class TrajectoryStoreReader {
+    public:
+        // Checks the header and the run index before returning true
+        bool open(const std::string& path, std::string& error);
+        void close() { file.close(); }
+
+        std::uint64_t getRunCount() const { return header().run_count; }
+        std::uint64_t getSampleCount() const { return header().sample_count; }
+        float getPhysicsDt() const { return header().physics_dt; }
+
+        StoredRun getRun(std::size_t index) const;
+
+        // A whole column (getRunCount() or getSampleCount() entries)
+        const void* getColumn(StoreColumn column) const;
+
+    private:
+        const TrajectoryStoreHeader& header() const;
+
+        MappedFile file;
+};
+
+// Traces every launch of the sweep on the scheduler's threads and appends them to
+// "store" in launch order. Returns false if the store could not be written.
+bool writeSweepStore(const LaunchSweepConfig& config, TaskScheduler& scheduler, TrajectoryStoreWriter& store);
+
+#endif
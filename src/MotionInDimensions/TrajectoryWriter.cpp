@@ -0,0 +1,175 @@
+#include "TrajectoryWriter.h"
+#include "TraceCapture.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char kMagic[8] = { 'P', 'H', 'Y', 'S', 'T', 'R', 'J', '1' };
+    const std::uint32_t kVersion = 1;
+    const char kCsvHeader[] = "run,t_s,x_m,y_m,vx_m_s,vy_m_s\n";
+
+    // Samples taken from the ring per pass
+    const std::size_t kPopBatch = 4096;
+
+    // Longest CSV line: u32 plus five "%.9g" floats and separators
+    const std::size_t kMaxCsvLine = 10 + 5 * 16 + 6;
+
+    template <typename T>
+    void appendValue(std::vector<char>& out, const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+TrajectoryFormat getTrajectoryFormatForPath(const std::string& path) {
+    const std::string extension = ".csv";
+    bool is_csv = path.size() >= extension.size()
+        && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+    return is_csv ? TrajectoryFormat::Csv : TrajectoryFormat::Binary;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Simulation Side
+//-------------------------------------------------------------------------------------------------
+TrajectoryWriter::TrajectoryWriter(std::size_t bufferSamples, std::size_t chunkBytes)
+    : ring(bufferSamples), chunk_bytes(chunkBytes)
+{
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    close();
+}
+
+bool TrajectoryWriter::open(const std::string& path, TrajectoryFormat fmt) {
+    close();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    format = fmt;
+    stopping.store(false);
+    write_error.store(false);
+    written.store(0);
+    dropped.store(0);
+    bytes.store(0);
+
+    chunk.clear();
+    chunk.reserve(chunk_bytes + kMaxCsvLine * kPopBatch);
+    if (format == TrajectoryFormat::Csv) {
+        chunk.insert(chunk.end(), kCsvHeader, kCsvHeader + sizeof(kCsvHeader) - 1);
+    }
+    else {
+        chunk.insert(chunk.end(), kMagic, kMagic + sizeof(kMagic));
+        appendValue(chunk, kVersion);
+    }
+
+    writer = std::thread(&TrajectoryWriter::writerLoop, this);
+    return true;
+}
+
+bool TrajectoryWriter::push(const TrajectorySample& sample) {
+    if (!ring.tryPush(sample)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool TrajectoryWriter::push(std::uint32_t run, float t_s, const BallState& state) {
+    return push(TrajectorySample{ run, t_s, state.x_m, state.y_m, state.vx_m_s, state.vy_m_s });
+}
+
+bool TrajectoryWriter::pushWait(const TrajectorySample& sample) {
+    if (!writer.joinable()) {
+        return false;
+    }
+    while (!ring.tryPush(sample)) {
+        std::this_thread::yield(); // the writer thread is busy draining the ring
+    }
+    return true;
+}
+
+bool TrajectoryWriter::pushWait(std::uint32_t run, float t_s, const BallState& state) {
+    return pushWait(TrajectorySample{ run, t_s, state.x_m, state.y_m, state.vx_m_s, state.vy_m_s });
+}
+
+void TrajectoryWriter::close() {
+    if (writer.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Writer Thread
+//-------------------------------------------------------------------------------------------------
+void TrajectoryWriter::writerLoop() {
+    setTraceThreadName("Trajectory writer");
+    std::vector<TrajectorySample> batch(kPopBatch);
+
+    for (;;) {
+        // Read the flag before draining, so samples pushed before close() are never lost
+        bool stop = stopping.load(std::memory_order_acquire);
+
+        std::size_t count = ring.popBulk(batch.data(), batch.size());
+        if (count > 0) {
+            appendSamples(batch.data(), count);
+            if (chunk.size() >= chunk_bytes) {
+                flushChunk();
+            }
+            continue;
+        }
+
+        if (stop) {
+            break;
+        }
+
+        // Nothing to do: back off briefly (the simulation never waits on this thread)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    flushChunk();
+    file.flush();
+}
+
+void TrajectoryWriter::appendSamples(const TrajectorySample* samples, std::size_t count) {
+    if (format == TrajectoryFormat::Binary) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const TrajectorySample& s = samples[i];
+            appendValue(chunk, s.run);
+            appendValue(chunk, s.t_s);
+            appendValue(chunk, s.x_m);
+            appendValue(chunk, s.y_m);
+            appendValue(chunk, s.vx_m_s);
+            appendValue(chunk, s.vy_m_s);
+        }
+    }
+    else {
+        char line[kMaxCsvLine];
+        for (std::size_t i = 0; i < count; ++i) {
+            const TrajectorySample& s = samples[i];
+            int length = std::snprintf(line, sizeof(line), "%u,%.9g,%.9g,%.9g,%.9g,%.9g\n",
+                static_cast<unsigned int>(s.run), s.t_s, s.x_m, s.y_m, s.vx_m_s, s.vy_m_s);
+            chunk.insert(chunk.end(), line, line + length);
+        }
+    }
+    written.fetch_add(count, std::memory_order_relaxed);
+}
+
+void TrajectoryWriter::flushChunk() {
+    if (chunk.empty()) {
+        return;
+    }
+    TraceZone zone("Write chunk");
+    if (!file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()))) {
+        write_error.store(true, std::memory_order_relaxed);
+    }
+    bytes.fetch_add(chunk.size(), std::memory_order_relaxed);
+    chunk.clear();
+}
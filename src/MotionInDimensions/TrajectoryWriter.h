@@ -0,0 +1,96 @@
+#pragma once
+#ifndef TRAJECTORY_WRITER_H
+#define TRAJECTORY_WRITER_H
+
+#include "BallState.h"
+#include "SpscRingBuffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Trajectory Export
+//
+// Streams ball states to disk without the physics loop ever waiting on I/O. The
+// simulation thread pushes samples into a lock-free ring buffer; a background thread
+// drains it, formats the samples into a large chunk and writes whole chunks at once.
+// If the disk falls behind and the ring fills up, push() drops new samples (and counts
+// them) instead of stalling the simulation; offline tools use pushWait() to keep them all.
+//
+// Formats:
+//     Csv     "run,t_s,x_m,y_m,vx_m_s,vy_m_s" header, one line per sample
+//     Binary  "PHYSTRJ1" u32 version, then packed samples: u32 run, f32 t, x, y, vx, vy
+//             (native byte order, 24 bytes each)
+//-------------------------------------------------------------------------------------------------
+
+struct TrajectorySample {
+    std::uint32_t run;   // which throw / launch the sample belongs to
+    float t_s;           // time since launch
+    float x_m, y_m;
+    float vx_m_s, vy_m_s;
+};
+
+enum class TrajectoryFormat {
+    Csv,
+    Binary
+};
+
+// ".csv" files are written as CSV, anything else as binary
+TrajectoryFormat getTrajectoryFormatForPath(const std::string& path);
+
+class TrajectoryWriter {
+    public:
+        // bufferSamples: ring buffer size between the simulation and the writer thread
+        // chunkBytes: how much formatted data is collected before each write
+        explicit TrajectoryWriter(std::size_t bufferSamples = 1 << 16, std::size_t chunkBytes = 1 << 20);
+        ~TrajectoryWriter();
+
+        TrajectoryWriter(const TrajectoryWriter&) = delete;
+        TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+        // Opens the file and starts the writer thread
+        bool open(const std::string& path, TrajectoryFormat format);
+        bool isOpen() const { return writer.joinable(); }
+
+        // Simulation side: never blocks. Returns false if the sample had to be dropped.
+        bool push(const TrajectorySample& sample);
+        bool push(std::uint32_t run, float t_s, const BallState& state);
+
+        // Offline side (no frame to keep): waits for room in the ring instead of dropping.
+        // Returns false only if the writer isn't open.
+        bool pushWait(const TrajectorySample& sample);
+        bool pushWait(std::uint32_t run, float t_s, const BallState& state);
+
+        // Writes everything still buffered, stops the thread and closes the file
+        void close();
+
+        std::uint64_t getSamplesWritten() const { return written.load(std::memory_order_relaxed); }
+        std::uint64_t getSamplesDropped() const { return dropped.load(std::memory_order_relaxed); }
+        std::uint64_t getBytesWritten() const { return bytes.load(std::memory_order_relaxed); }
+        bool hasWriteError() const { return write_error.load(std::memory_order_relaxed); }
+
+    private:
+        void writerLoop();
+        void appendSamples(const TrajectorySample* samples, std::size_t count);
+        void flushChunk();
+
+        SpscRingBuffer<TrajectorySample> ring;
+        std::size_t chunk_bytes;
+        std::vector<char> chunk; // only touched by the writer thread
+
+        std::ofstream file;
+        TrajectoryFormat format = TrajectoryFormat::Csv;
+        std::thread writer;
+
+        std::atomic<bool> stopping{ false };
+        std::atomic<bool> write_error{ false };
+        std::atomic<std::uint64_t> written{ 0 };
+        std::atomic<std::uint64_t> dropped{ 0 };
+        std::atomic<std::uint64_t> bytes{ 0 };
+};
+
+#endif
@@ -1,6 +1,6 @@
 #include "Particle.h"
 
-Particle::Particle(const sf::Vector2f& pos, const sf::Vector2f& vel, float m) :
+Particle::Particle(const Vec2f& pos, const Vec2f& vel, float m) :
 	position(pos), velocity(vel), mass(m) {
 		// The constructor sets the particles starting position, velocity, and mass
 		// acceleration starts at (0,0) by default
@@ -8,20 +8,15 @@ Particle::Particle(const sf::Vector2f& pos, const sf::Vector2f& vel, float m) :
 
 void Particle::update(float dt) {
 	// This function moves the particle over a step of time (dt)
-
-	// velocity = velocity + acceleration * dt
-	velocity += acceleration * dt;
-
-	// position = position + velocity * dt
-	position += velocity * dt;
-
-	// After we move, we can reset acceleration if we want so that
+	// using semi-implicit Euler:
+	//     velocity = velocity + acceleration * dt
+	//     position = position + velocity * dt
+	// After we move, acceleration is reset so that
 	// each frame we can apply new forces
-	 
-	acceleration = sf::Vector2f(0.f, 0.f);
+	integrate<SemiImplicitEuler>(dt);
 }
 
-void Particle::applyForce(const sf::Vector2f &force) {
+void Particle::applyForce(const Vec2f &force) {
 	// Force changes acceleration
 	// a = F/m
 
@@ -29,15 +24,15 @@ void Particle::applyForce(const sf::Vector2f &force) {
 }
 
 // Set parameter functions
-void Particle::setPosition(const sf::Vector2f& pos) {
+void Particle::setPosition(const Vec2f& pos) {
 	position = pos;
 }
 
-void Particle::setVelocity(const sf::Vector2f& vel) {
+void Particle::setVelocity(const Vec2f& vel) {
 	velocity = vel;
 }
 
-void Particle::setAcceleration(const sf::Vector2f& acc) {
+void Particle::setAcceleration(const Vec2f& acc) {
 	acceleration = acc;
 }
 
@@ -45,15 +40,15 @@ void Particle::setMass(float m) {
 	mass = m;
 }
 
-const sf::Vector2f& Particle::getPosition() const {
+const Vec2f& Particle::getPosition() const {
 	return position;
 }
 
-const sf::Vector2f& Particle::getVelocity() const {
+const Vec2f& Particle::getVelocity() const {
 	return velocity;
 }
 
-const sf::Vector2f& Particle::getAcceleration() const {
+const Vec2f& Particle::getAcceleration() const {
 	return acceleration;
 }
 
@@ -0,0 +1,107 @@
+#include "ParticleSystem.h"
+#include "IntegrationKernels.h"
+
+void ParticleSystem::reserve(std::size_t count) {
+	x.reserve(count);
+	y.reserve(count);
+	vx.reserve(count);
+	vy.reserve(count);
+	ax.reserve(count);
+	ay.reserve(count);
+	invMass.reserve(count);
+}
+
+void ParticleSystem::clear() {
+	x.clear();
+	y.clear();
+	vx.clear();
+	vy.clear();
+	ax.clear();
+	ay.clear();
+	invMass.clear();
+}
+
+std::size_t ParticleSystem::addParticle(const Particle& particle) {
+	std::size_t index = addParticle(particle.getPosition(), particle.getVelocity(), particle.getMass());
+
+	// Keep any force that was already applied to the particle
+	ax[index] = particle.getAcceleration().x;
+	ay[index] = particle.getAcceleration().y;
+	return index;
+}
+
+std::size_t ParticleSystem::addParticle(const Vec2f& pos, const Vec2f& vel, float mass) {
+	x.push_back(pos.x);
+	y.push_back(pos.y);
+	vx.push_back(vel.x);
+	vy.push_back(vel.y);
+	ax.push_back(0.f);
+	ay.push_back(0.f);
+	invMass.push_back(1.f / mass);
+	return x.size() - 1;
+}
+
+void ParticleSystem::step(float dt) {
+	// Same order as Particle::update, but for every particle in one pass:
+	//     velocity += acceleration * dt
+	//     position += velocity * dt
+	//     acceleration = 0
+	// The kernel is the fastest SIMD version this CPU supports (see IntegrationKernels.h)
+	static const IntegrationKernel kernel = getBestIntegrationKernel();
+
+	IntegrationBuffers buffers = { x.data(), y.data(), vx.data(), vy.data(), ax.data(), ay.data(), size() };
+	kernel(buffers, dt);
+}
+
+void ParticleSystem::step(float dt, TaskScheduler& scheduler) {
+	static const IntegrationKernel kernel = getBestIntegrationKernel();
+
+	// Work is split in blocks of 16 floats (one cache line), so two threads never write the same line
+	const std::size_t block = 16;
+	const std::size_t count = size();
+	const std::size_t blocks = (count + block - 1) / block;
+
+	scheduler.parallelFor(0, blocks, 1024, [&](std::size_t first_block, std::size_t last_block) {
+		std::size_t begin = first_block * block;
+		std::size_t end = last_block * block < count ? last_block * block : count;
+		IntegrationBuffers chunk = { x.data() + begin, y.data() + begin, vx.data() + begin, vy.data() + begin,
+			ax.data() + begin, ay.data() + begin, end - begin };
+		kernel(chunk, dt);
+	});
+}
+
+void ParticleSystem::applyForce(std::size_t index, const Vec2f& force) {
+	// a = F/m
+	ax[index] += force.x * invMass[index];
+	ay[index] += force.y * invMass[index];
+}
+
+void ParticleSystem::applyAcceleration(const Vec2f& acc) {
+	const std::size_t count = size();
+	for (std::size_t i = 0; i < count; ++i) {
+		ax[i] += acc.x;
+		ay[i] += acc.y;
+	}
+}
+
+Particle ParticleSystem::getParticle(std::size_t index) const {
+	Particle particle(getPosition(index), getVelocity(index), getMass(index));
+	particle.setAcceleration(getAcceleration(index));
+	return particle;
+}
+
+Vec2f ParticleSystem::getPosition(std::size_t index) const {
+	return Vec2f(x[index], y[index]);
+}
+
+Vec2f ParticleSystem::getVelocity(std::size_t index) const {
+	return Vec2f(vx[index], vy[index]);
+}
+
+Vec2f ParticleSystem::getAcceleration(std::size_t index) const {
+	return Vec2f(ax[index], ay[index]);
+}
+
+float ParticleSystem::getMass(std::size_t index) const {
+	return 1.f / invMass[index];
+}
@@ -0,0 +1,62 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+int FrameProfiler::addZone(const char* name) {
+	for (int z = 0; z < zone_count; ++z) {
+		if (std::strcmp(zone_names[z], name) == 0) {
+			return z;
+		}
+	}
+	if (zone_count == kMaxZones) {
+		return -1;
+	}
+	zone_names[zone_count] = name;
+	return zone_count++;
+}
+
+void FrameProfiler::endFrame() {
+	if constexpr (kProfilingEnabled) {
+		float* frame = history[next_frame];
+		for (int z = 0; z < kMaxZones; ++z) {
+			frame[z] = static_cast<float>(current[z]) * 1e-6f;
+		}
+		auto frame_end = Clock::now();
+		frame[kWholeFrame] = std::chrono::duration<float, std::milli>(frame_end - frame_start).count();
+		if constexpr (kAllocationTrackingEnabled) {
+			AllocationCounts* allocations = allocation_history[next_frame];
+			for (int z = 0; z < kMaxZones; ++z) {
+				allocations[z] = current_allocations[z];
+			}
+			AllocationCounts now = getThreadAllocations();
+			allocations[kWholeFrame].count = now.count - frame_allocations_start.count;
+			allocations[kWholeFrame].bytes = now.bytes - frame_allocations_start.bytes;
+		}
+		if (isTraceCapturing()) {
+			recordTraceEvent("Frame",
+				std::chrono::duration_cast<std::chrono::nanoseconds>(frame_start.time_since_epoch()).count(),
+				std::chrono::duration_cast<std::chrono::nanoseconds>(frame_end.time_since_epoch()).count());
+		}
+
+		next_frame = (next_frame + 1) % kHistoryFrames;
+		frame_count = std::min(frame_count + 1, kHistoryFrames);
+	}
+}
+
+float FrameProfiler::getPercentileMs(int zone, float percentile) const {
+	if (frame_count == 0) {
+		return 0.f;
+	}
+
+	float values[kHistoryFrames];
+	for (int i = 0; i < frame_count; ++i) {
+		values[i] = getMs(zone, i);
+	}
+
+	// Nearest-rank percentile
+	int rank = static_cast<int>(percentile * (frame_count - 1) + 0.5f);
+	rank = std::max(0, std::min(rank, frame_count - 1));
+	std::nth_element(values, values + rank, values + frame_count);
+	return values[rank];
+}
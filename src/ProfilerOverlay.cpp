@@ -0,0 +1,134 @@
+#include "ProfilerOverlay.h"
+
+#include <cstdio>
+
+//-------------------------------------------------------------------------------------------------
+// Layout
+//-------------------------------------------------------------------------------------------------
+static const float kPanelX = 10.f;
+static const float kPanelY = 10.f;
+static const float kPadding = 8.f;
+static const float kBarWidth = 2.f;                  // pixels per frame
+static const float kGraphHeight = 140.f;
+static const float kGraphMs = 33.4f;                 // milliseconds at the top of the graph
+static const float kFrameBudgetMs = 1000.f / 60.f;   // 60 FPS line
+static const float kLineHeight = 18.f;
+static const unsigned int kTextSize = 14;
+
+static const sf::Color kZoneColors[FrameProfiler::kMaxZones] = {
+	sf::Color(230, 80, 80),   // red
+	sf::Color(80, 200, 120),  // green
+	sf::Color(80, 150, 240),  // blue
+	sf::Color(240, 200, 60),  // yellow
+	sf::Color(200, 100, 230), // purple
+	sf::Color(60, 210, 220),  // cyan
+	sf::Color(250, 150, 60),  // orange
+	sf::Color(180, 180, 180)  // grey
+};
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font)
+	: bars(sf::Quads), budget_line(sf::Lines, 2)
+{
+	panel.setFillColor(sf::Color(0, 0, 0, 180));
+
+	// Full size once, so the bars never reallocate while the history fills up
+	bars.resize(static_cast<std::size_t>(FrameProfiler::kHistoryFrames) * FrameProfiler::kMaxZones * 4);
+	for (HudText& line : lines) {
+		line.getText().setFont(font);
+		line.getText().setCharacterSize(kTextSize);
+		line.getText().setFillColor(sf::Color::White);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Drawing
+//-------------------------------------------------------------------------------------------------
+void ProfilerOverlay::draw(sf::RenderTarget& target, const FrameProfiler& profiler, const SpriteBatchStats* batchStats) {
+	if (!visible) {
+		return;
+	}
+
+	const sf::View old_view = target.getView();
+	target.setView(target.getDefaultView());
+
+	const int zones = profiler.getZoneCount();
+	const int text_lines = zones + (batchStats != nullptr ? 2 : 1);
+	const float graph_width = FrameProfiler::kHistoryFrames * kBarWidth;
+	const float graph_left = kPanelX + kPadding;
+	const float graph_bottom = kPanelY + kPadding + kGraphHeight;
+	const float pixels_per_ms = kGraphHeight / kGraphMs;
+
+	panel.setPosition(kPanelX, kPanelY);
+	panel.setSize(sf::Vector2f(graph_width + 2.f * kPadding,
+		kGraphHeight + 3.f * kPadding + text_lines * kLineHeight));
+	target.draw(panel);
+
+	if (!kProfilingEnabled) {
+		lines[0].setString("Profiling is compiled out (build with PHYSIM_PROFILING=1)");
+		lines[0].getText().setPosition(graph_left, graph_bottom + kPadding);
+		target.draw(lines[0].getText());
+		target.setView(old_view);
+		return;
+	}
+
+	// Stacked bars, newest frame at the right edge
+	const int frames = profiler.getFrameCount();
+	bars.resize(static_cast<std::size_t>(frames) * zones * 4);
+	std::size_t vertex = 0;
+	for (int f = 0; f < frames; ++f) {
+		float x = graph_left + graph_width - (f + 1) * kBarWidth;
+		float y = graph_bottom;
+		for (int z = 0; z < zones; ++z) {
+			float height = profiler.getMs(z, f) * pixels_per_ms;
+			if (y - height < graph_bottom - kGraphHeight) {
+				height = y - (graph_bottom - kGraphHeight); // clip at the top of the graph
+			}
+			bars[vertex++] = sf::Vertex(sf::Vector2f(x, y), kZoneColors[z]);
+			bars[vertex++] = sf::Vertex(sf::Vector2f(x + kBarWidth, y), kZoneColors[z]);
+			bars[vertex++] = sf::Vertex(sf::Vector2f(x + kBarWidth, y - height), kZoneColors[z]);
+			bars[vertex++] = sf::Vertex(sf::Vector2f(x, y - height), kZoneColors[z]);
+			y -= height;
+		}
+	}
+	target.draw(bars);
+
+	// Frame budget line
+	float budget_y = graph_bottom - kFrameBudgetMs * pixels_per_ms;
+	budget_line[0] = sf::Vertex(sf::Vector2f(graph_left, budget_y), sf::Color(255, 255, 255, 140));
+	budget_line[1] = sf::Vertex(sf::Vector2f(graph_left + graph_width, budget_y), sf::Color(255, 255, 255, 140));
+	target.draw(budget_line);
+
+	// Legend with p50 / p99 (and the last frame's allocations) per zone, then the whole
+	// frame (a line only re-lays out its glyphs when its digits change)
+	char buffer[HudText::kMaxLength + 1];
+	float text_y = graph_bottom + kPadding;
+	for (int z = 0; z <= zones; ++z) {
+		int zone = z < zones ? z : FrameProfiler::kWholeFrame;
+		int length = std::snprintf(buffer, sizeof(buffer), "%-10s p50 %6.2f ms   p99 %6.2f ms",
+			z < zones ? profiler.getZoneName(z) : "Frame",
+			profiler.getPercentileMs(zone, 0.5f), profiler.getPercentileMs(zone, 0.99f));
+		if (kAllocationTrackingEnabled && length > 0 && length < static_cast<int>(sizeof(buffer))) {
+			// Heap allocations in the last frame (0 in a steady frame)
+			std::snprintf(buffer + length, sizeof(buffer) - length, "   %4llu allocs",
+				static_cast<unsigned long long>(profiler.getAllocations(zone, 0).count));
+		}
+		sf::Text& line = lines[z].getText();
+		lines[z].setString(buffer);
+		line.setFillColor(z < zones ? kZoneColors[z] : sf::Color::White);
+		line.setPosition(graph_left, text_y);
+		target.draw(line);
+		text_y += kLineHeight;
+	}
+
+	if (batchStats != nullptr) {
+		sf::Text& line = lines[zones + 1].getText();
+		std::snprintf(buffer, sizeof(buffer), "Draw calls %u   vertices %u   batched quads %u",
+			batchStats->draw_calls, batchStats->vertices, batchStats->quads);
+		lines[zones + 1].setString(buffer);
+		line.setFillColor(sf::Color::White);
+		line.setPosition(graph_left, text_y);
+		target.draw(line);
+	}
+
+	target.setView(old_view);
+}
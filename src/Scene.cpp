@@ -0,0 +1,182 @@
+#include "Scene.h"
+#include "AllocationTracker.h"
+#include "TraceCapture.h"
+
+#include <iostream>
+#include <utility>
+
+SceneStack::SceneStack(sf::RenderWindow& window, const sf::Font& overlayFont)
+	: window(window), profiler_overlay(overlayFont)
+{
+	zone_events = profiler.addZone("Events");
+	zone_draw = profiler.addZone("Draw");
+	zone_display = profiler.addZone("Display");
+}
+
+//-------------------------------------------------------------------------------------------------
+// Scene Changes
+//-------------------------------------------------------------------------------------------------
+void SceneStack::push(std::unique_ptr<Scene> scene) {
+	changes.push_back(Change{ ChangeType::Push, std::move(scene) });
+}
+
+void SceneStack::pop() {
+	changes.push_back(Change{ ChangeType::Pop, nullptr });
+}
+
+void SceneStack::replace(std::unique_ptr<Scene> scene) {
+	changes.push_back(Change{ ChangeType::Replace, std::move(scene) });
+}
+
+void SceneStack::applyChanges() {
+	if (changes.empty()) {
+		return;
+	}
+	TraceZone zone("Scene change");
+
+	// A change may queue further changes (e.g. from a destructor), so take the list first
+	std::vector<Change> pending;
+	pending.swap(changes);
+
+	bool resumed = false;
+	for (Change& change : pending) {
+		if (change.type != ChangeType::Push && !scenes.empty()) {
+			scenes.pop_back();
+			resumed = change.type == ChangeType::Pop;
+		}
+		if (change.type != ChangeType::Pop) {
+			scenes.push_back(std::move(change.scene));
+			resumed = false;
+		}
+	}
+
+	redraw = true;
+	steady_frames = 0;
+	if (!scenes.empty()) {
+		if (resumed) {
+			scenes.back()->onResume();
+		}
+		window.setTitle(scenes.back()->getTitle());
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Frame Loop
+//-------------------------------------------------------------------------------------------------
+void SceneStack::dispatchEvent(Scene& scene, const sf::Event& event) {
+	if (event.type == sf::Event::Closed) {
+		window.close();
+	}
+	else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+		profiler_overlay.toggle();
+		redraw = true;
+	}
+	else if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus) {
+		redraw = true;
+	}
+	scene.handleEvent(event);
+}
+
+// The overlay shows live timings, so it keeps the frames coming while it's open
+bool SceneStack::needsRedraw(const Scene& scene) const {
+	return redraw || scene.isAnimating() || profiler_overlay.isVisible();
+}
+
+// A frame that only animated the same scene must not touch the heap; the warm-up frames
+// before that let vertex arrays, glyph pages etc. reach their final size. "frame" is read
+// from the tracker directly, so the check works without profiling compiled in.
+void SceneStack::checkAllocations(const AllocationCounts& frame) {
+	if (steady_frames < allocation_check_warmup) {
+		++steady_frames;
+		return;
+	}
+
+	if (frame.count == 0) {
+		return;
+	}
+	++allocation_failures;
+	std::cerr << "Allocation check: frame " << frame_index << " of '" << scenes.back()->getTitle() << "' made "
+		<< frame.count << " allocations (" << frame.bytes << " bytes)";
+	if (kProfilingEnabled) {
+		std::cerr << ":";
+		for (int z = 0; z < profiler.getZoneCount(); ++z) {
+			const AllocationCounts& zone = profiler.getAllocations(z, 0);
+			if (zone.count > 0) {
+				std::cerr << " " << profiler.getZoneName(z) << " " << zone.count;
+			}
+		}
+	}
+	std::cerr << "\n";
+}
+
+void SceneStack::run() {
+	applyChanges();
+
+	sf::Clock frame_clock;
+	while (window.isOpen() && !scenes.empty()) {
+		Scene& scene = *scenes.back();
+
+		// Idle: the picture can't change before the next event, so sleep until one arrives
+		// instead of drawing the same frame 60 times a second
+		sf::Event event;
+		const bool waited = !needsRedraw(scene);
+		if (waited) {
+			if (!window.waitEvent(event)) {
+				break;
+			}
+			frame_clock.restart(); // time spent asleep isn't frame time
+		}
+
+		float frame_time = frame_clock.restart().asSeconds();
+		profiler.beginFrame();
+		const AllocationCounts frame_start = getThreadAllocations();
+
+		ScopedTimer events_timer(profiler, zone_events);
+		if (waited) {
+			dispatchEvent(scene, event);
+		}
+		while (window.pollEvent(event)) {
+			dispatchEvent(scene, event);
+		}
+		events_timer.stop();
+
+		// Events that changed nothing (e.g. the mouse moving over the menu) don't draw a
+		// frame, and the profiler doesn't count them
+		if (needsRedraw(scene)) {
+			const bool steady = !redraw;
+			redraw = false;
+
+			// Scenes time their own update zones (e.g. "Update" and "Physics")
+			scene.update(frame_time);
+
+			ScopedTimer draw_timer(profiler, zone_draw);
+			window.clear();
+			sprite_batch.resetStats();
+			scene.draw(window, sprite_batch);
+			sprite_batch.flush(window);
+			profiler_overlay.draw(window, profiler, &sprite_batch.getStats());
+			draw_timer.stop();
+
+			// Present the frame (includes waiting for the frame rate limit)
+			ScopedTimer display_timer(profiler, zone_display);
+			window.display();
+			display_timer.stop();
+
+			profiler.endFrame();
+			++frame_index;
+
+			if (steady && allocation_check_warmup >= 0) {
+				AllocationCounts frame = getThreadAllocations();
+				frame.count -= frame_start.count;
+				frame.bytes -= frame_start.bytes;
+				checkAllocations(frame);
+			}
+		}
+
+		applyChanges();
+	}
+
+	// Scenes go away while the window (and its OpenGL context) still exists
+	changes.clear();
+	scenes.clear();
+}
@@ -0,0 +1,145 @@
+#include "SimulationRegistry.h"
+#include "TraceCapture.h"
+
+#include <algorithm>
+
+ResourceCache<TextureAtlas>::Handle loadAtlas(const AtlasManifest& manifest, std::string& error) {
+	return ResourceCache<TextureAtlas>::getDefault().load(manifest.cache_path, [&](TextureAtlas& atlas, std::string& atlas_error) {
+		for (const auto& image : manifest.images) {
+			atlas.addFile(image.first, image.second);
+		}
+		return atlas.build(atlas_error, manifest.cache_path);
+	}, error);
+}
+
+bool loadAssets(const AssetManifest& manifest, std::string& error) {
+	for (const std::string& font : manifest.fonts) {
+		if (!ResourceCache<sf::Font>::getDefault().load(font, error)) {
+			return false;
+		}
+	}
+	for (const AtlasManifest& atlas : manifest.atlases) {
+		if (!loadAtlas(atlas, error)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+SimulationRegistry::~SimulationRegistry() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	changed.notify_all();
+	if (loader.joinable()) {
+		loader.join();
+	}
+}
+
+void SimulationRegistry::add(SimulationInfo info) {
+	entries.push_back(Entry{ std::move(info), AssetState::NotLoaded });
+}
+
+std::vector<std::string> SimulationRegistry::getTopics() const {
+	std::vector<std::string> topics;
+	for (const Entry& entry : entries) {
+		if (std::find(topics.begin(), topics.end(), entry.info.topic) == topics.end()) {
+			topics.push_back(entry.info.topic);
+		}
+	}
+	return topics;
+}
+
+std::vector<const SimulationInfo*> SimulationRegistry::getSimulations(const std::string& topic) const {
+	std::vector<const SimulationInfo*> simulations;
+	for (const Entry& entry : entries) {
+		if (entry.info.topic == topic) {
+			simulations.push_back(&entry.info);
+		}
+	}
+	return simulations;
+}
+
+const SimulationInfo* SimulationRegistry::find(const std::string& name) const {
+	for (const Entry& entry : entries) {
+		if (entry.info.name == name) {
+			return &entry.info;
+		}
+	}
+	return nullptr;
+}
+
+SimulationRegistry::Entry* SimulationRegistry::findEntry(const SimulationInfo& info) {
+	for (Entry& entry : entries) {
+		if (&entry.info == &info) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Prefetching
+//-------------------------------------------------------------------------------------------------
+void SimulationRegistry::prefetch(const SimulationInfo& info) {
+	Entry* entry = findEntry(info);
+	if (!entry) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (entry->state != AssetState::NotLoaded || stopping) {
+		return;
+	}
+	entry->state = AssetState::Queued;
+	queue.push_back(entry);
+	if (!loader.joinable()) {
+		loader = std::thread(&SimulationRegistry::loaderLoop, this);
+	}
+	changed.notify_all();
+}
+
+std::unique_ptr<Scene> SimulationRegistry::createScene(const SimulationInfo& info, SceneStack& stack,
+	SessionRecorder* recorder, std::string& error) {
+	if (Entry* entry = findEntry(info)) {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (entry->state == AssetState::Queued) {
+			// Not started yet: load it here instead of waiting behind the rest of the queue
+			queue.erase(std::find(queue.begin(), queue.end(), entry));
+			entry->state = AssetState::NotLoaded;
+		}
+		changed.wait(lock, [&] { return entry->state != AssetState::Loading; });
+	}
+
+	TraceZone zone("Create scene");
+	return info.create(stack, recorder, error);
+}
+
+void SimulationRegistry::loaderLoop() {
+	setTraceThreadName("Asset loader");
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;) {
+		changed.wait(lock, [&] { return stopping || !queue.empty(); });
+		if (stopping) {
+			return;
+		}
+		Entry* entry = queue.front();
+		queue.pop_front();
+		entry->state = AssetState::Loading;
+		lock.unlock();
+
+		// A failed prefetch is forgotten; createScene() then loads again and reports the error
+		bool loaded;
+		{
+			TraceZone zone("Prefetch assets");
+			std::string error;
+			loaded = loadAssets(entry->info.assets, error);
+		}
+
+		lock.lock();
+		entry->state = loaded ? AssetState::Loaded : AssetState::NotLoaded;
+		changed.notify_all();
+	}
+}
@@ -0,0 +1,83 @@
+#include "SkylinePacker.h"
+
+#include <algorithm>
+
+SkylinePacker::SkylinePacker(int width, int height) : width(width), height(height) {
+	skyline.push_back(Segment{ 0, 0, width });
+}
+
+int SkylinePacker::fitAt(std::size_t index, int rectWidth, int rectHeight) const {
+	const int x = skyline[index].x;
+	if (x + rectWidth > width) {
+		return -1;
+	}
+
+	// The rectangle rests on the highest segment it spans
+	int y = 0;
+	int remaining = rectWidth;
+	for (std::size_t i = index; remaining > 0; ++i) {
+		y = std::max(y, skyline[i].y);
+		remaining -= skyline[i].width;
+	}
+	return y + rectHeight <= height ? y : -1;
+}
+
+bool SkylinePacker::insert(int rectWidth, int rectHeight, int& x, int& y) {
+	if (rectWidth <= 0 || rectHeight <= 0) {
+		return false;
+	}
+
+	// Lowest top edge wins, then the narrowest segment (leaves wider gaps usable)
+	std::size_t best_index = skyline.size();
+	int best_top = height + 1;
+	int best_width = width + 1;
+	for (std::size_t i = 0; i < skyline.size(); ++i) {
+		int fit_y = fitAt(i, rectWidth, rectHeight);
+		if (fit_y < 0) {
+			continue;
+		}
+		int top = fit_y + rectHeight;
+		if (top < best_top || (top == best_top && skyline[i].width < best_width)) {
+			best_index = i;
+			best_top = top;
+			best_width = skyline[i].width;
+			y = fit_y;
+		}
+	}
+	if (best_index == skyline.size()) {
+		return false;
+	}
+	x = skyline[best_index].x;
+
+	// The rectangle's top becomes a new segment...
+	skyline.insert(skyline.begin() + best_index, Segment{ x, best_top, rectWidth });
+
+	// ...which hides (or shortens) the segments below it
+	const int right = x + rectWidth;
+	std::size_t i = best_index + 1;
+	while (i < skyline.size() && skyline[i].x < right) {
+		int overlap = right - skyline[i].x;
+		if (overlap >= skyline[i].width) {
+			skyline.erase(skyline.begin() + i);
+		}
+		else {
+			skyline[i].x += overlap;
+			skyline[i].width -= overlap;
+			break;
+		}
+	}
+
+	// Join neighbours at the same height
+	for (std::size_t s = 0; s + 1 < skyline.size();) {
+		if (skyline[s].y == skyline[s + 1].y) {
+			skyline[s].width += skyline[s + 1].width;
+			skyline.erase(skyline.begin() + s + 1);
+		}
+		else {
+			++s;
+		}
+	}
+
+	used_height = std::max(used_height, best_top);
+	return true;
+}
@@ -0,0 +1,117 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+
+SpatialHash::SpatialHash(float cellSize) {
+	setCellSize(cellSize);
+}
+
+void SpatialHash::setCellSize(float size) {
+	cellSize = size;
+	invCellSize = 1.f / size;
+}
+
+void SpatialHash::build(const ParticleSystem& system) {
+	build(system.positionsX(), system.positionsY(), system.size());
+}
+
+void SpatialHash::build(const float* x, const float* y, std::size_t count) {
+	// Bounding box of the particles, in cells
+	float min_x = 0.f, min_y = 0.f, max_x = 0.f, max_y = 0.f;
+	if (count > 0) {
+		min_x = max_x = x[0];
+		min_y = max_y = y[0];
+	}
+	for (std::size_t i = 1; i < count; ++i) {
+		min_x = std::min(min_x, x[i]);
+		max_x = std::max(max_x, x[i]);
+		min_y = std::min(min_y, y[i]);
+		max_y = std::max(max_y, y[i]);
+	}
+	originX = cellCoord(min_x);
+	originY = cellCoord(min_y);
+	gridWidth = static_cast<std::uint32_t>(cellCoord(max_x) - originX) + 1;
+	const double grid_cells = static_cast<double>(gridWidth) * (static_cast<double>(cellCoord(max_y) - originY) + 1.0);
+
+	// Table size: a power of two that fits the whole grid if it is not much bigger
+	// than the particle count, otherwise 2 * count so buckets stay sparse
+	std::size_t wanted = count * 2;
+	if (grid_cells <= static_cast<double>(count) * 4.0) {
+		wanted = std::max(wanted, static_cast<std::size_t>(grid_cells));
+	}
+	std::size_t bucket_count = 16;
+	while (bucket_count < wanted) bucket_count <<= 1;
+	bucketMask = static_cast<std::uint32_t>(bucket_count - 1);
+
+	cellStart.assign(bucket_count + 1, 0);
+	cellCursor.resize(bucket_count);
+	particleBucket.resize(count);
+	sortedIndices.resize(count);
+	sortedX.resize(count);
+	sortedY.resize(count);
+
+	// 1) Hash every particle and count how many land in each bucket
+	for (std::size_t i = 0; i < count; ++i) {
+		std::uint32_t bucket = bucketOf(cellCoord(x[i]), cellCoord(y[i]));
+		particleBucket[i] = bucket;
+		++cellStart[bucket + 1];
+	}
+
+	// 2) Prefix sum: cellStart[b] becomes the first sorted slot of bucket b
+	for (std::size_t b = 0; b < bucket_count; ++b) {
+		cellStart[b + 1] += cellStart[b];
+	}
+
+	// 3) Scatter particles into their bucket's slots
+	std::copy(cellStart.begin(), cellStart.end() - 1, cellCursor.begin());
+	for (std::size_t i = 0; i < count; ++i) {
+		std::uint32_t slot = cellCursor[particleBucket[i]]++;
+		sortedIndices[slot] = static_cast<std::uint32_t>(i);
+		sortedX[slot] = x[i];
+		sortedY[slot] = y[i];
+	}
+}
+
+int SpatialHash::gatherSlotRanges(float px, float py, float radius, SlotRange* ranges) const {
+	const std::int32_t min_cx = cellCoord(px - radius);
+	const std::int32_t max_cx = cellCoord(px + radius);
+	const std::int32_t min_cy = cellCoord(py - radius);
+	const std::int32_t max_cy = cellCoord(py + radius);
+
+	// Too many cells for the range list (radius well above the cell size): every slot
+	const std::int64_t cells = (static_cast<std::int64_t>(max_cx) - min_cx + 1) * (static_cast<std::int64_t>(max_cy) - min_cy + 1);
+	if (cells > kMaxQueryRanges) {
+		ranges[0] = SlotRange{ 0, static_cast<std::uint32_t>(sortedIndices.size()) };
+		return 1;
+	}
+
+	std::uint32_t buckets[kMaxQueryRanges];
+	int count = 0;
+	for (std::int32_t cy = min_cy; cy <= max_cy; ++cy) {
+		for (std::int32_t cx = min_cx; cx <= max_cx; ++cx) {
+			std::uint32_t bucket = bucketOf(cx, cy);
+
+			// Two different cells can hash to the same bucket: only visit it once
+			bool seen = false;
+			for (int i = 0; i < count; ++i) {
+				if (buckets[i] == bucket) {
+					seen = true;
+					break;
+				}
+			}
+			if (!seen) {
+				buckets[count] = bucket;
+				ranges[count] = SlotRange{ cellStart[bucket], cellStart[bucket + 1] };
+				++count;
+			}
+		}
+	}
+	return count;
+}
+
+void SpatialHash::findNeighbourPairs(float radius, std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs) const {
+	pairs.clear();
+	forEachNeighbourPair(radius, [&pairs](std::uint32_t i, std::uint32_t j) {
+		pairs.emplace_back(i, j);
+	});
+}
@@ -0,0 +1,80 @@
+#include "SpriteBatch.h"
+
+SpriteBatch::SpriteBatch() : vertices(sf::Quads) {}
+
+//-------------------------------------------------------------------------------------------------
+// Queuing
+//-------------------------------------------------------------------------------------------------
+void SpriteBatch::draw(const sf::Sprite& sprite, const sf::BlendMode& blend) {
+	const sf::FloatRect bounds = sprite.getLocalBounds();
+	const sf::Transform& transform = sprite.getTransform();
+	const sf::Vector2f corners[4] = {
+		transform.transformPoint(0.f, 0.f),
+		transform.transformPoint(bounds.width, 0.f),
+		transform.transformPoint(bounds.width, bounds.height),
+		transform.transformPoint(0.f, bounds.height)
+	};
+	const sf::IntRect rect = sprite.getTextureRect();
+	drawQuad(sprite.getTexture(), corners,
+		sf::FloatRect(static_cast<float>(rect.left), static_cast<float>(rect.top),
+			static_cast<float>(rect.width), static_cast<float>(rect.height)),
+		sprite.getColor(), blend);
+}
+
+void SpriteBatch::draw(const sf::RectangleShape& rect, const sf::BlendMode& blend) {
+	const sf::Vector2f size = rect.getSize();
+	const sf::Transform& transform = rect.getTransform();
+	const sf::Vector2f corners[4] = {
+		transform.transformPoint(0.f, 0.f),
+		transform.transformPoint(size.x, 0.f),
+		transform.transformPoint(size.x, size.y),
+		transform.transformPoint(0.f, size.y)
+	};
+	const sf::IntRect texture_rect = rect.getTextureRect();
+	drawQuad(rect.getTexture(), corners,
+		sf::FloatRect(static_cast<float>(texture_rect.left), static_cast<float>(texture_rect.top),
+			static_cast<float>(texture_rect.width), static_cast<float>(texture_rect.height)),
+		rect.getFillColor(), blend);
+}
+
+void SpriteBatch::drawQuad(const sf::Texture* texture, const sf::Vector2f corners[4], const sf::FloatRect& textureRect,
+	const sf::Color& color, const sf::BlendMode& blend) {
+	// Same state as the last quad: extend its batch, otherwise start a new one
+	if (batches.empty() || batches.back().texture != texture || batches.back().blend != blend) {
+		batches.push_back(Batch{ texture, blend, vertices.getVertexCount(), 0 });
+	}
+
+	const float left = textureRect.left;
+	const float right = textureRect.left + textureRect.width;
+	const float top = textureRect.top;
+	const float bottom = textureRect.top + textureRect.height;
+	vertices.append(sf::Vertex(corners[0], color, sf::Vector2f(left, top)));
+	vertices.append(sf::Vertex(corners[1], color, sf::Vector2f(right, top)));
+	vertices.append(sf::Vertex(corners[2], color, sf::Vector2f(right, bottom)));
+	vertices.append(sf::Vertex(corners[3], color, sf::Vector2f(left, bottom)));
+	batches.back().vertex_count += 4;
+	++stats.quads;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Drawing
+//-------------------------------------------------------------------------------------------------
+void SpriteBatch::draw(sf::RenderTarget& target, const sf::Drawable& drawable, const sf::RenderStates& states) {
+	flush(target);
+	target.draw(drawable, states);
+	++stats.draw_calls;
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+	for (const Batch& batch : batches) {
+		sf::RenderStates states(batch.blend);
+		states.texture = batch.texture;
+		target.draw(&vertices[batch.first_vertex], batch.vertex_count, sf::Quads, states);
+		++stats.draw_calls;
+		stats.vertices += static_cast<unsigned int>(batch.vertex_count);
+	}
+
+	// Keeps the memory for the next frame
+	vertices.clear();
+	batches.clear();
+}
@@ -0,0 +1,110 @@
+#include "SweptCollision.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool sweepSegmentCircle(const Vec2f& p0, const Vec2f& p1,
+	const Vec2f& center, float radius, float& toi) {
+	// Solve |p0 + d*t - center|^2 = radius^2 for t:
+	//     (d.d) t^2 + 2 (m.d) t + (m.m - r^2) = 0,   m = p0 - center
+	const Vec2f d = p1 - p0;
+	const Vec2f m = p0 - center;
+
+	const float c = m.x * m.x + m.y * m.y - radius * radius;
+	if (c < 0.f) {
+		// Already inside at the start of the step
+		toi = 0.f;
+		return true;
+	}
+
+	const float a = d.x * d.x + d.y * d.y;
+	const float b = m.x * d.x + m.y * d.y;
+	if (a <= 0.f || b >= 0.f) {
+		// Not moving, or moving away from the circle
+		return false;
+	}
+
+	const float disc = b * b - a * c;
+	if (disc < 0.f) {
+		// The line misses the circle
+		return false;
+	}
+
+	// First (entering) root
+	const float t = (-b - std::sqrt(disc)) / a;
+	if (t > 1.f) {
+		return false;
+	}
+
+	toi = std::max(t, 0.f);
+	return true;
+}
+
+bool sweepSegmentAABB(const Vec2f& p0, const Vec2f& p1,
+	const Vec2f& boxMin, const Vec2f& boxMax, float& toi) {
+	// Slab method: clip [0, 1] against the x slab and then the y slab
+	const float start[2] = { p0.x, p0.y };
+	const float delta[2] = { p1.x - p0.x, p1.y - p0.y };
+	const float lo[2] = { boxMin.x, boxMin.y };
+	const float hi[2] = { boxMax.x, boxMax.y };
+
+	float t_enter = 0.f;
+	float t_leave = 1.f;
+	for (int axis = 0; axis < 2; ++axis) {
+		if (delta[axis] == 0.f) {
+			// Moving parallel to this slab: must already be between its planes
+			if (start[axis] < lo[axis] || start[axis] > hi[axis]) return false;
+			continue;
+		}
+
+		float t0 = (lo[axis] - start[axis]) / delta[axis];
+		float t1 = (hi[axis] - start[axis]) / delta[axis];
+		if (t0 > t1) std::swap(t0, t1);
+
+		t_enter = std::max(t_enter, t0);
+		t_leave = std::min(t_leave, t1);
+		if (t_enter > t_leave) return false;
+	}
+
+	toi = t_enter;
+	return true;
+}
+
+bool sweepSegmentExitAABB(const Vec2f& p0, const Vec2f& p1,
+	const Vec2f& boxMin, const Vec2f& boxMax, float& toi) {
+	if (p0.x < boxMin.x || p0.x > boxMax.x || p0.y < boxMin.y || p0.y > boxMax.y) {
+		// Already outside at the start of the step
+		toi = 0.f;
+		return true;
+	}
+
+	// Earliest time any coordinate crosses the wall it is moving towards
+	const float start[2] = { p0.x, p0.y };
+	const float end[2] = { p1.x, p1.y };
+	const float lo[2] = { boxMin.x, boxMin.y };
+	const float hi[2] = { boxMax.x, boxMax.y };
+
+	bool leaves = false;
+	float t_exit = 1.f;
+	for (int axis = 0; axis < 2; ++axis) {
+		const float delta = end[axis] - start[axis];
+		float t = 1.f;
+		if (end[axis] > hi[axis]) {
+			t = (hi[axis] - start[axis]) / delta;
+		}
+		else if (end[axis] < lo[axis]) {
+			t = (lo[axis] - start[axis]) / delta;
+		}
+		else {
+			continue;
+		}
+
+		leaves = true;
+		t_exit = std::min(t_exit, t);
+	}
+
+	if (leaves) {
+		toi = t_exit;
+	}
+	return leaves;
+}
@@ -0,0 +1,168 @@
+#include "TaskScheduler.h"
+#include "TraceCapture.h"
+
+#include <utility>
+
+// Which scheduler/queue the current thread works for (-1 = not a worker)
+static thread_local TaskScheduler* tl_scheduler = nullptr;
+static thread_local int tl_queue = -1;
+
+//-------------------------------------------------------------------------------------------------
+// TaskGroup
+//-------------------------------------------------------------------------------------------------
+TaskGroup::TaskGroup(TaskScheduler& scheduler) : scheduler(scheduler) {}
+
+TaskGroup::~TaskGroup() {
+    wait();
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    // The callable lives on the heap until the task has run
+    auto* holder = new std::function<void()>(std::move(task));
+    auto invoke = [](void* context, std::size_t, std::size_t) {
+        auto* fn = static_cast<std::function<void()>*>(context);
+        (*fn)();
+        delete fn;
+    };
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    scheduler.submit({ invoke, holder, 0, 0, this });
+}
+
+void TaskGroup::wait() {
+    const int own_queue = (tl_scheduler == &scheduler) ? tl_queue : -1;
+
+    // Help out instead of blocking: run any queued task until this group is done
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!scheduler.tryRunOne(own_queue)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// WorkQueue
+//-------------------------------------------------------------------------------------------------
+void TaskScheduler::WorkQueue::pushBack(const Task& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == ring.size()) {
+        // Grow: unwrap the ring into a buffer twice the size
+        std::vector<Task> bigger(ring.empty() ? 64 : ring.size() * 2);
+        for (std::size_t i = 0; i < count; ++i) {
+            bigger[i] = ring[(head + i) % ring.size()];
+        }
+        ring.swap(bigger);
+        head = 0;
+    }
+    ring[(head + count) % ring.size()] = task;
+    ++count;
+}
+
+bool TaskScheduler::WorkQueue::popBack(Task& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) return false;
+    --count;
+    task = ring[(head + count) % ring.size()];
+    return true;
+}
+
+bool TaskScheduler::WorkQueue::popFront(Task& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) return false;
+    task = ring[head];
+    head = (head + 1) % ring.size();
+    --count;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// TaskScheduler
+//-------------------------------------------------------------------------------------------------
+TaskScheduler::TaskScheduler(unsigned int threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+    }
+
+    // The thread that waits on the work is one of the "threadCount" threads
+    const unsigned int worker_count = threadCount - 1;
+    queueCount = worker_count > 0 ? worker_count : 1;
+    queues.reset(new WorkQueue[queueCount]);
+
+    workers.reserve(worker_count);
+    for (unsigned int i = 0; i < worker_count; ++i) {
+        workers.emplace_back(&TaskScheduler::workerLoop, this, static_cast<int>(i));
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+TaskScheduler& TaskScheduler::getDefault() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+void TaskScheduler::submit(const Task& task) {
+    // Workers keep their new tasks local; other threads spread them round-robin
+    std::size_t queue = (tl_scheduler == this && tl_queue >= 0)
+        ? static_cast<std::size_t>(tl_queue)
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queueCount;
+    queues[queue].pushBack(task);
+
+    queuedTasks.fetch_add(1);
+    {
+        // Taking the lock makes sure a worker that is about to sleep sees the new task
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_one();
+}
+
+bool TaskScheduler::tryRunOne(int preferredQueue) {
+    Task task;
+
+    // Newest task from our own queue first
+    if (preferredQueue >= 0 && queues[preferredQueue].popBack(task)) {
+        queuedTasks.fetch_sub(1);
+        execute(task);
+        return true;
+    }
+
+    // Otherwise steal the oldest task from someone else
+    const std::size_t start = preferredQueue >= 0 ? static_cast<std::size_t>(preferredQueue) + 1 : 0;
+    for (std::size_t i = 0; i < queueCount; ++i) {
+        std::size_t victim = (start + i) % queueCount;
+        if (queues[victim].popFront(task)) {
+            queuedTasks.fetch_sub(1);
+            execute(task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::execute(const Task& task) {
+    task.invoke(task.context, task.begin, task.end);
+    task.group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskScheduler::workerLoop(int index) {
+    tl_scheduler = this;
+    tl_queue = index;
+    setTraceThreadName("Worker " + std::to_string(index + 1));
+
+    while (!stopping.load()) {
+        if (tryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping.load() || queuedTasks.load() > 0; });
+    }
+}
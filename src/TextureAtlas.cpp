@@ -0,0 +1,209 @@
+#include "TextureAtlas.h"
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// Every image gets a 1 pixel border that repeats its edge pixels, so smooth filtering
+// never blends in the neighbouring image
+static const int kPadding = 1;
+static const int kMinAtlasWidth = 256;
+static const char kManifestMagic[] = "PHYSATLAS1";
+
+// Size and modification time of a file, to tell whether a cached atlas is stale
+static bool getFileStamp(const std::string& path, std::uintmax_t& size, long long& modified) {
+	std::error_code error;
+	size = std::filesystem::file_size(path, error);
+	if (error) {
+		return false;
+	}
+	auto time = std::filesystem::last_write_time(path, error);
+	if (error) {
+		return false;
+	}
+	modified = static_cast<long long>(time.time_since_epoch().count());
+	return true;
+}
+
+void TextureAtlas::addFile(const std::string& name, const std::string& path) {
+	sources.push_back(Source{ name, path });
+}
+
+sf::IntRect TextureAtlas::getRect(const std::string& name) const {
+	auto it = rects.find(name);
+	return it != rects.end() ? it->second : sf::IntRect();
+}
+
+sf::Sprite TextureAtlas::makeSprite(const std::string& name) const {
+	return sf::Sprite(texture, getRect(name));
+}
+
+bool TextureAtlas::build(std::string& error, const std::string& cachePath) {
+	if (!cachePath.empty() && loadCache(cachePath)) {
+		return true;
+	}
+
+	sf::Image image;
+	if (!pack(image, error)) {
+		return false;
+	}
+	if (!texture.loadFromImage(image)) {
+		error = "Could not create the atlas texture.";
+		return false;
+	}
+
+	if (!cachePath.empty()) {
+		saveCache(cachePath, image);
+	}
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Packing
+//-------------------------------------------------------------------------------------------------
+bool TextureAtlas::pack(sf::Image& image, std::string& error) {
+	std::vector<sf::Image> images(sources.size());
+	int widest = 0;
+	for (std::size_t i = 0; i < sources.size(); ++i) {
+		if (!images[i].loadFromFile(sources[i].path)) {
+			error = "Could not load '" + sources[i].path + "'.";
+			return false;
+		}
+		widest = std::max(widest, static_cast<int>(images[i].getSize().x) + 2 * kPadding);
+	}
+
+	// Tallest first packs tightest
+	std::vector<std::size_t> order(sources.size());
+	for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+		return images[a].getSize().y > images[b].getSize().y;
+	});
+
+	// Try every power-of-two width and keep the one with the smallest area
+	const int max_size = static_cast<int>(sf::Texture::getMaximumSize());
+	int width = kMinAtlasWidth;
+	while (width < widest) width *= 2;
+
+	std::vector<sf::Vector2i> best_positions;
+	int best_width = 0;
+	int best_height = 0;
+	for (; width <= max_size; width *= 2) {
+		SkylinePacker packer(width, max_size);
+		std::vector<sf::Vector2i> positions(sources.size());
+		bool fits = true;
+		for (std::size_t i : order) {
+			sf::Vector2u size = images[i].getSize();
+			if (!packer.insert(static_cast<int>(size.x) + 2 * kPadding, static_cast<int>(size.y) + 2 * kPadding,
+				positions[i].x, positions[i].y)) {
+				fits = false;
+				break;
+			}
+		}
+		if (fits && (best_width == 0 || static_cast<long long>(width) * packer.getUsedHeight() <
+			static_cast<long long>(best_width) * best_height)) {
+			best_positions = positions;
+			best_width = width;
+			best_height = packer.getUsedHeight();
+		}
+	}
+	if (best_width == 0) {
+		error = "The images don't fit in one " + std::to_string(max_size) + " pixel texture.";
+		return false;
+	}
+
+	// Copy every image in, with its edges repeated into the padding
+	image.create(static_cast<unsigned int>(best_width), static_cast<unsigned int>(std::max(best_height, 1)), sf::Color::Transparent);
+	rects.clear();
+	for (std::size_t i = 0; i < sources.size(); ++i) {
+		const sf::Image& source = images[i];
+		const int w = static_cast<int>(source.getSize().x);
+		const int h = static_cast<int>(source.getSize().y);
+		const unsigned int x = static_cast<unsigned int>(best_positions[i].x + kPadding);
+		const unsigned int y = static_cast<unsigned int>(best_positions[i].y + kPadding);
+
+		image.copy(source, x, y);
+		if (w > 0 && h > 0) {
+			image.copy(source, x - 1, y, sf::IntRect(0, 0, 1, h));
+			image.copy(source, x + w, y, sf::IntRect(w - 1, 0, 1, h));
+			image.copy(source, x, y - 1, sf::IntRect(0, 0, w, 1));
+			image.copy(source, x, y + h, sf::IntRect(0, h - 1, w, 1));
+		}
+		rects[sources[i].name] = sf::IntRect(static_cast<int>(x), static_cast<int>(y), w, h);
+	}
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Cache
+//
+// <cache>.atlas holds one line per image: name, path, file size, modification time and
+// the rectangle, separated by tabs. The cache is only used when every line still
+// matches the queued files.
+//-------------------------------------------------------------------------------------------------
+bool TextureAtlas::loadCache(const std::string& cachePath) {
+	std::ifstream manifest(cachePath + ".atlas");
+	std::string line;
+	if (!manifest || !std::getline(manifest, line) || line != kManifestMagic) {
+		return false;
+	}
+
+	std::map<std::string, sf::IntRect> cached_rects;
+	for (const Source& source : sources) {
+		if (!std::getline(manifest, line)) {
+			return false;
+		}
+		std::istringstream fields(line);
+		std::string name, path;
+		std::uintmax_t size = 0;
+		long long modified = 0;
+		sf::IntRect rect;
+		if (!std::getline(fields, name, '\t') || !std::getline(fields, path, '\t') ||
+			!(fields >> size >> modified >> rect.left >> rect.top >> rect.width >> rect.height)) {
+			return false;
+		}
+
+		std::uintmax_t current_size;
+		long long current_modified;
+		if (name != source.name || path != source.path || !getFileStamp(path, current_size, current_modified) ||
+			current_size != size || current_modified != modified) {
+			return false;
+		}
+		cached_rects[name] = rect;
+	}
+
+	// Nothing may follow the listed images (a different set of files)
+	if (std::getline(manifest, line) && !line.empty()) {
+		return false;
+	}
+	if (!texture.loadFromFile(cachePath + ".png")) {
+		return false;
+	}
+	rects = cached_rects;
+	return true;
+}
+
+void TextureAtlas::saveCache(const std::string& cachePath, const sf::Image& image) const {
+	// A cache that can't be written only means packing again next time
+	std::error_code error;
+	std::filesystem::path parent = std::filesystem::path(cachePath).parent_path();
+	if (!parent.empty()) {
+		std::filesystem::create_directories(parent, error);
+	}
+	if (!image.saveToFile(cachePath + ".png")) {
+		return;
+	}
+
+	std::ofstream manifest(cachePath + ".atlas");
+	manifest << kManifestMagic << '\n';
+	for (const Source& source : sources) {
+		std::uintmax_t size = 0;
+		long long modified = 0;
+		getFileStamp(source.path, size, modified);
+		const sf::IntRect& rect = rects.at(source.name);
+		manifest << source.name << '\t' << source.path << '\t' << size << ' ' << modified << ' '
+			<< rect.left << ' ' << rect.top << ' ' << rect.width << ' ' << rect.height << '\n';
+	}
+}
@@ -0,0 +1,271 @@
+#include "TraceCapture.h"
+#include "SpscRingBuffer.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+std::atomic<bool> trace_detail::capturing{ false };
+
+namespace {
+	struct TraceEvent {
+		const char* name;
+		std::int64_t start_ns;
+		std::int64_t end_ns;
+	};
+
+	// Events each thread can hold between two writer passes (~384 KB per thread)
+	static const std::size_t kThreadBufferEvents = 16384;
+
+	// How often the writer thread empties the buffers
+	static const int kFlushIntervalMs = 5;
+
+	// Events taken from one buffer per pop, and JSON bytes collected before a file write
+	static const std::size_t kPopBatch = 1024;
+	static const std::size_t kWriteBytes = 64 * 1024;
+
+	struct ThreadBuffer {
+		SpscRingBuffer<TraceEvent> events{ kThreadBufferEvents };
+		std::atomic<std::uint64_t> dropped{ 0 };
+		int tid = 0;
+		std::string name; // guarded by TraceState::mutex
+	};
+
+	struct TraceState {
+		std::mutex control; // one start/stop at a time
+
+		std::mutex mutex; // guards "buffers", the buffer names and "next_tid"
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		int next_tid = 1;
+
+		std::ofstream file; // only the writer thread touches it while capturing
+		std::string text;
+		std::int64_t origin_ns = 0;
+		bool first_event = true;
+		std::uint64_t dropped = 0; // from buffers whose threads are gone
+
+		std::thread writer;
+		std::mutex wake_mutex;
+		std::condition_variable wake;
+		bool stopping = false;
+	};
+
+	TraceState& getState() {
+		static TraceState state;
+		return state;
+	}
+
+	// The registry keeps each buffer alive after its thread exits, until it's been emptied
+	thread_local std::shared_ptr<ThreadBuffer> tl_buffer;
+	thread_local std::string tl_thread_name;
+
+	ThreadBuffer* registerThread() {
+		TraceState& state = getState();
+		auto buffer = std::make_shared<ThreadBuffer>();
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+			buffer->tid = state.next_tid++;
+			buffer->name = tl_thread_name;
+			state.buffers.push_back(buffer);
+		}
+		tl_buffer = buffer;
+		return buffer.get();
+	}
+
+	void appendJsonString(std::string& out, const char* text) {
+		out += '"';
+		for (const char* c = text; *c; ++c) {
+			if (*c == '"' || *c == '\\') out += '\\';
+			if (static_cast<unsigned char>(*c) >= 0x20) out += *c;
+		}
+		out += '"';
+	}
+
+	void beginRecord(TraceState& state) {
+		state.text += state.first_event ? "\n" : ",\n";
+		state.first_event = false;
+	}
+
+	// One complete ("X") event, times in microseconds from the start of the capture
+	void appendEvent(TraceState& state, int tid, const TraceEvent& event) {
+		beginRecord(state);
+		state.text += "{\"name\":";
+		appendJsonString(state.text, event.name);
+
+		char numbers[96];
+		std::snprintf(numbers, sizeof(numbers), ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+			tid, (event.start_ns - state.origin_ns) * 1e-3, (event.end_ns - event.start_ns) * 1e-3);
+		state.text += numbers;
+	}
+
+	// Metadata event that labels a thread's row in the viewer
+	void appendThreadName(TraceState& state, int tid, const std::string& name) {
+		if (name.empty()) {
+			return;
+		}
+		beginRecord(state);
+		state.text += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) + ",\"args\":{\"name\":";
+		appendJsonString(state.text, name.c_str());
+		state.text += "}}";
+	}
+
+	void writeText(TraceState& state) {
+		state.file.write(state.text.data(), static_cast<std::streamsize>(state.text.size()));
+		state.text.clear();
+	}
+
+	// Moves every buffered event into the file. Buffers of finished threads are
+	// dropped once empty (after their thread's name has been written).
+	void drainBuffers(TraceState& state) {
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+			buffers = state.buffers;
+		}
+
+		TraceEvent batch[kPopBatch];
+		for (auto& buffer : buffers) {
+			std::size_t count;
+			while ((count = buffer->events.popBulk(batch, kPopBatch)) > 0) {
+				for (std::size_t i = 0; i < count; ++i) {
+					appendEvent(state, buffer->tid, batch[i]);
+				}
+				if (state.text.size() >= kWriteBytes) {
+					writeText(state);
+				}
+			}
+		}
+		buffers.clear();
+
+		std::lock_guard<std::mutex> lock(state.mutex);
+		for (std::size_t i = 0; i < state.buffers.size();) {
+			ThreadBuffer& buffer = *state.buffers[i];
+			// Only the registry still holds it, so its thread has exited
+			if (state.buffers[i].use_count() == 1 && buffer.events.size() == 0) {
+				appendThreadName(state, buffer.tid, buffer.name);
+				state.dropped += buffer.dropped.load(std::memory_order_relaxed);
+				state.buffers.erase(state.buffers.begin() + i);
+			}
+			else {
+				++i;
+			}
+		}
+		writeText(state);
+	}
+
+	void writerLoop() {
+		TraceState& state = getState();
+		for (;;) {
+			bool stop;
+			{
+				std::unique_lock<std::mutex> lock(state.wake_mutex);
+				state.wake.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs), [&] { return state.stopping; });
+				stop = state.stopping;
+			}
+
+			// Drains after reading the flag, so events recorded before stop() are kept
+			drainBuffers(state);
+			if (stop) {
+				break;
+			}
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Capture Control
+//-------------------------------------------------------------------------------------------------
+bool startTraceCapture(const std::string& path, std::string& error) {
+	TraceState& state = getState();
+	std::lock_guard<std::mutex> control(state.control);
+	if (isTraceCapturing()) {
+		error = "A trace capture is already running.";
+		return false;
+	}
+
+	state.file.open(path, std::ios::binary | std::ios::trunc);
+	if (!state.file) {
+		error = "Could not write '" + path + "'.";
+		return false;
+	}
+
+	// Throw away events left over from an earlier capture (no writer thread is running,
+	// so this thread is the only consumer)
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		TraceEvent batch[kPopBatch];
+		for (auto& buffer : state.buffers) {
+			while (buffer->events.popBulk(batch, kPopBatch) > 0) {}
+			buffer->dropped.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	state.text = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	state.first_event = true;
+	state.dropped = 0;
+	state.origin_ns = getTraceTime();
+	state.stopping = false;
+
+	trace_detail::capturing.store(true, std::memory_order_relaxed);
+	state.writer = std::thread(writerLoop);
+	return true;
+}
+
+std::uint64_t stopTraceCapture() {
+	TraceState& state = getState();
+	std::lock_guard<std::mutex> control(state.control);
+	if (!isTraceCapturing()) {
+		return 0;
+	}
+
+	trace_detail::capturing.store(false, std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(state.wake_mutex);
+		state.stopping = true;
+	}
+	state.wake.notify_one();
+	state.writer.join();
+
+	// Names of the threads that are still running, then the end of the JSON
+	std::uint64_t dropped = state.dropped;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		for (auto& buffer : state.buffers) {
+			appendThreadName(state, buffer->tid, buffer->name);
+			dropped += buffer->dropped.load(std::memory_order_relaxed);
+		}
+	}
+	state.text += "\n]}\n";
+	writeText(state);
+	state.file.close();
+	return dropped;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Recording
+//-------------------------------------------------------------------------------------------------
+void recordTraceEvent(const char* name, std::int64_t startNs, std::int64_t endNs) {
+	if (!isTraceCapturing()) {
+		return;
+	}
+
+	ThreadBuffer* buffer = tl_buffer.get();
+	if (buffer == nullptr) {
+		buffer = registerThread();
+	}
+	if (!buffer->events.tryPush(TraceEvent{ name, startNs, endNs })) {
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void setTraceThreadName(const std::string& name) {
+	tl_thread_name = name;
+	if (tl_buffer) {
+		std::lock_guard<std::mutex> lock(getState().mutex);
+		tl_buffer->name = name;
+	}
+}